@@ -17,6 +17,32 @@ namespace Puerts
         }
 
         public abstract void LowMemoryNotification();
+
+        // call at the end of each frame with the remaining frame time, GC work is done within that slack
+        public bool OnFrameIdle(double idleBudgetInSeconds)
+        {
+#if THREAD_SAFE
+            lock(this) {
+#endif
+#if !EXPERIMENTAL_IL2CPP_PUERTS || !ENABLE_IL2CPP
+            return PuertsDLL.OnFrameIdle(env.isolate, idleBudgetInSeconds) != 0;
+#else
+            return PuertsIl2cpp.NativeAPI.OnFrameIdle(env.nativeJsEnv, idleBudgetInSeconds) != 0;
+#endif
+#if THREAD_SAFE
+            }
+#endif
+        }
+
+        // json with separate GC pause histograms for in-frame and idle pauses, empty before the first OnFrameIdle
+        public string GetGCPauseReport()
+        {
+#if !EXPERIMENTAL_IL2CPP_PUERTS || !ENABLE_IL2CPP
+            return PuertsDLL.GetGCPauseReport(env.isolate);
+#else
+            return PuertsIl2cpp.NativeAPI.GetGCPauseReport(env.nativeJsEnv);
+#endif
+        }
     }
 
     public class BackendV8 : Backend
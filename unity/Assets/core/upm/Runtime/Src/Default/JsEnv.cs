@@ -100,7 +100,18 @@ namespace Puerts
         {
         }
 
+        // maxHeapSizeMB为js堆（老生代）上限，接近上限时终止当前执行而不是让进程崩溃，0表示使用默认值
+        public JsEnv(ILoader loader, int debugPort, BackendType backend, int maxHeapSizeMB)
+            : this(loader, debugPort, backend, IntPtr.Zero, IntPtr.Zero, maxHeapSizeMB)
+        {
+        }
+
         public JsEnv(ILoader loader, int debugPort, BackendType backend, IntPtr externalRuntime, IntPtr externalContext)
+            : this(loader, debugPort, backend, externalRuntime, externalContext, 0)
+        {
+        }
+
+        JsEnv(ILoader loader, int debugPort, BackendType backend, IntPtr externalRuntime, IntPtr externalContext, int maxHeapSizeMB)
         {
             const int libVersionExpect = 34;
             int libVersion = PuertsDLL.GetApiLevel();
@@ -116,6 +127,10 @@ namespace Puerts
             {
                 isolate = PuertsDLL.CreateJSEngineWithExternalEnv((int)backend, externalRuntime, externalContext);
             }
+            else if (maxHeapSizeMB > 0)
+            {
+                isolate = PuertsDLL.CreateJSEngineWithHeapBudget((int)backend, maxHeapSizeMB, 0);
+            }
             else
             {
                 isolate = PuertsDLL.CreateJSEngine((int)backend);
@@ -760,6 +775,49 @@ namespace Puerts
 #endif
         }
 
+        // 结果写成.cpuprofile，可直接拖入Chrome DevTools的Performance面板
+        public bool StartCpuProfiling(string title, int samplingIntervalUs = 0)
+        {
+#if THREAD_SAFE
+            lock(this) {
+#endif
+            CheckLiveness();
+            return PuertsDLL.StartCpuProfiling(isolate, title, samplingIntervalUs) != 0;
+#if THREAD_SAFE
+            }
+#endif
+        }
+
+        public bool StopCpuProfiling(string title, string outputPath)
+        {
+#if THREAD_SAFE
+            lock(this) {
+#endif
+            CheckLiveness();
+            return PuertsDLL.StopCpuProfiling(isolate, title, outputPath) != 0;
+#if THREAD_SAFE
+            }
+#endif
+        }
+
+        // 按绑定统计调用次数和耗时，对所有JsEnv生效
+        public static void SetBindingProfilerEnabled(bool enabled)
+        {
+            PuertsDLL.SetBindingProfilerEnabled(enabled ? 1 : 0);
+        }
+
+        public static void ResetBindingProfiler()
+        {
+            PuertsDLL.ResetBindingProfiler();
+        }
+
+        // 返回按总耗时降序的json数组，maxEntries为0时返回全部
+        public string GetBindingProfileReport(int maxEntries = 0)
+        {
+            CheckLiveness();
+            return PuertsDLL.GetBindingProfileReport(isolate, maxEntries);
+        }
+
 #if CSHARP_7_3_OR_NEWER
         TaskCompletionSource<bool> waitDebugerTaskSource;
         public Task WaitDebuggerAsync()
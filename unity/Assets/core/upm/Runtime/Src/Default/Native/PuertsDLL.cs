@@ -104,6 +104,9 @@ namespace Puerts
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr CreateJSEngineWithExternalEnv(int backendType, IntPtr externalRuntime, IntPtr externalContext);
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr CreateJSEngineWithHeapBudget(int backendType, int maxOldGenerationSizeMB, int maxYoungGenerationSizeMB);
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern void DestroyJSEngine(IntPtr isolate);
 
@@ -609,6 +612,41 @@ namespace Puerts
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern void LogicTick(IntPtr isolate);
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int OnFrameIdle(IntPtr isolate, double idleBudgetInSeconds);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr GetGCPauseReport(IntPtr isolate, out int strlen);
+
+        public static string GetGCPauseReport(IntPtr isolate)
+        {
+            int strlen;
+            IntPtr str = GetGCPauseReport(isolate, out strlen);
+            return GetStringFromNative(str, strlen);
+        }
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int StartCpuProfiling(IntPtr isolate, string title, int samplingIntervalUs);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int StopCpuProfiling(IntPtr isolate, string title, string outputPath);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SetBindingProfilerEnabled(int enabled);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ResetBindingProfiler();
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr GetBindingProfileReport(IntPtr isolate, int maxEntries, out int strlen);
+
+        public static string GetBindingProfileReport(IntPtr isolate, int maxEntries)
+        {
+            int strlen;
+            IntPtr str = GetBindingProfileReport(isolate, maxEntries, out strlen);
+            return GetStringFromNative(str, strlen);
+        }
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern void SetLogCallback(IntPtr log, IntPtr logWarning, IntPtr logError);
 
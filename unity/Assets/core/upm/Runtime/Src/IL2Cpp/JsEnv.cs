@@ -21,7 +21,7 @@ namespace Puerts
     [UnityEngine.Scripting.Preserve]
     public class JsEnv : IDisposable
     {
-        IntPtr nativeJsEnv;
+        internal IntPtr nativeJsEnv;
         IntPtr nativePesapiEnv;
 
         // TypeRegister TypeRegister;
@@ -61,7 +61,10 @@ namespace Puerts
 
         public JsEnv(): this(new DefaultLoader(), -1) {}
 
-        public JsEnv(ILoader loader, int debugPort = -1)
+        public JsEnv(ILoader loader, int debugPort = -1): this(loader, debugPort, 0) {}
+
+        // maxHeapSizeMB为js堆（老生代）上限，接近上限时终止当前执行而不是让进程崩溃，0表示使用默认值
+        public JsEnv(ILoader loader, int debugPort, int maxHeapSizeMB)
         {
             this.loader = loader;
 
@@ -77,7 +80,9 @@ namespace Puerts
             PuertsIl2cpp.NativeAPI.SetGlobalType_ArrayBuffer(typeof(ArrayBuffer));
             PuertsIl2cpp.NativeAPI.SetGlobalType_JSObject(typeof(JSObject));
 
-            nativeJsEnv = PuertsIl2cpp.NativeAPI.CreateNativeJSEnv();
+            nativeJsEnv = maxHeapSizeMB > 0
+                ? PuertsIl2cpp.NativeAPI.CreateNativeJSEnvWithHeapBudget(maxHeapSizeMB, 0)
+                : PuertsIl2cpp.NativeAPI.CreateNativeJSEnv();
             nativePesapiEnv = PuertsIl2cpp.NativeAPI.GetPesapiEnvHolder(nativeJsEnv);
 
             //PuertsIl2cpp.NativeAPI.SetObjectPool(objectPool, typeof(PuertsIl2cpp.ObjectPool).GetMethod("Add")); //TODO: remove....
@@ -205,6 +210,34 @@ namespace Puerts
 #endif
         }
 
+        // 结果写成.cpuprofile，可直接拖入Chrome DevTools的Performance面板
+        public bool StartCpuProfiling(string title, int samplingIntervalUs = 0)
+        {
+            return PuertsIl2cpp.NativeAPI.StartCpuProfiling(nativeJsEnv, title, samplingIntervalUs) != 0;
+        }
+
+        public bool StopCpuProfiling(string title, string outputPath)
+        {
+            return PuertsIl2cpp.NativeAPI.StopCpuProfiling(nativeJsEnv, title, outputPath) != 0;
+        }
+
+        // 按绑定统计调用次数和耗时，对所有JsEnv生效；il2cpp下只统计总耗时
+        public static void SetBindingProfilerEnabled(bool enabled)
+        {
+            PuertsIl2cpp.NativeAPI.SetBindingProfilerEnabled(enabled ? 1 : 0);
+        }
+
+        public static void ResetBindingProfiler()
+        {
+            PuertsIl2cpp.NativeAPI.ResetBindingProfiler();
+        }
+
+        // 返回按总耗时降序的json数组，maxEntries为0时返回全部
+        public string GetBindingProfileReport(int maxEntries = 0)
+        {
+            return PuertsIl2cpp.NativeAPI.GetBindingProfileReport(maxEntries);
+        }
+
 #if CSHARP_7_3_OR_NEWER
         TaskCompletionSource<bool> waitDebugerTaskSource;
         public Task WaitDebuggerAsync()
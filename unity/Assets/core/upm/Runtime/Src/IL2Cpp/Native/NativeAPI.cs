@@ -44,6 +44,9 @@ namespace PuertsIl2cpp
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr CreateNativeJSEnv();
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr CreateNativeJSEnvWithHeapBudget(int maxOldGenerationSizeMB, int maxYoungGenerationSizeMB);
+
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern void DestroyNativeJSEnv(IntPtr jsEnv);
 
@@ -110,6 +113,44 @@ namespace PuertsIl2cpp
         [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern bool LogicTick(IntPtr jsEnv);
 
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int OnFrameIdle(IntPtr jsEnv, double idleBudgetInSeconds);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr GetGCPauseReport(IntPtr jsEnv, out int strlen);
+
+        public static string GetGCPauseReport(IntPtr jsEnv)
+        {
+            int strlen;
+            IntPtr str = GetGCPauseReport(jsEnv, out strlen);
+            return Marshal.PtrToStringAnsi(str, strlen);
+        }
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int StartCpuProfiling(IntPtr jsEnv, string title, int samplingIntervalUs);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int StopCpuProfiling(IntPtr jsEnv, string title, string outputPath);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SetBindingProfilerEnabled(int enabled);
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ResetBindingProfiler();
+
+        [DllImport(DLLNAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr GetBindingProfileReport(int maxEntries, out int strlen);
+
+        public static string GetBindingProfileReport(int maxEntries)
+        {
+            int strlen;
+            IntPtr str = GetBindingProfileReport(maxEntries, out strlen);
+            if (str == IntPtr.Zero) return null;
+            byte[] buffer = new byte[strlen];
+            Marshal.Copy(str, buffer, 0, strlen);
+            return System.Text.Encoding.UTF8.GetString(buffer);
+        }
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static Func<string, Puerts.JSObject> GetModuleExecutor(IntPtr NativeJsEnvPtr, Type type)
         {
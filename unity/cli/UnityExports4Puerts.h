@@ -148,6 +148,10 @@ typedef void* (*GetRuntimeObjectFromPersistentObjectFunc)(pesapi_env env, pesapi
 
 typedef void (*SetRuntimeObjectToPersistentObjectFunc)(pesapi_env env, pesapi_value pvalue, void* runtimeObject);
 
+typedef const char* (*GetBindingNameFunc)(const void* key);
+
+typedef void (*RecordMethodCallFunc)(const void* key, GetBindingNameFunc getName, uint64_t totalNs, uint64_t convertNs);
+
 struct WrapData 
 {
     WrapFuncPtr Wrap;
@@ -221,6 +225,9 @@ struct UnityExports
 
     GetRuntimeObjectFromPersistentObjectFunc GetRuntimeObjectFromPersistentObject = nullptr;
     SetRuntimeObjectToPersistentObjectFunc SetRuntimeObjectToPersistentObject = nullptr;
+
+    // set by plugin while binding profiler is enabled, skip timing if null
+    RecordMethodCallFunc RecordMethodCall = nullptr;
 };
 
 }
\ No newline at end of file
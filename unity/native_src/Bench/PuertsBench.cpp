@@ -0,0 +1,643 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+// 无界面的绑定层基准测试，直接走 Puerts.cpp 导出的 C API（与 C# 侧调用路径一致），结果以 JSON 输出。
+// 用法：puerts_bench [--iterations N] [--filter 子串] [--out 文件]
+// 以 -DPUERTS_BENCH_FAST_CALL=ON 构建时额外输出 fastcall_* 项
+
+#include "JSEngine.h"
+#include "Log.h"
+
+#if !WITH_QUICKJS && defined(WITH_V8_FAST_CALL)
+#include <v8-fast-api-calls.h>
+#include <v8-version.h>
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// 与 V8FastCall.hpp 的启用条件一致：需要 FastApiCallbackOptions::fallback，V8 12 起没有了
+#if !WITH_QUICKJS && defined(WITH_V8_FAST_CALL) && V8_MAJOR_VERSION >= 9 && V8_MAJOR_VERSION < 12
+#define PUERTS_BENCH_FAST_CALL 1
+#else
+#define PUERTS_BENCH_FAST_CALL 0
+#endif
+
+using puerts::FResultInfo;
+using puerts::JSEngine;
+using puerts::JSFunction;
+
+extern "C"
+{
+    v8::Isolate* CreateJSEngine(int backend);
+    void DestroyJSEngine(v8::Isolate* Isolate);
+    int GetLibBackend(v8::Isolate* Isolate);
+    void SetGlobalFunction(v8::Isolate* Isolate, const char* Name, puerts::CSharpFunctionCallback Callback, int64_t Data);
+    FResultInfo* Eval(v8::Isolate* Isolate, const char* Code, const char* Path);
+    const char* GetLastExceptionInfo(v8::Isolate* Isolate, int* Length);
+    int _RegisterClass(v8::Isolate* Isolate, int BaseTypeId, const char* FullName, puerts::CSharpConstructorCallback Constructor,
+        puerts::CSharpDestructorCallback Destructor, int64_t Data);
+    int RegisterFunction(
+        v8::Isolate* Isolate, int ClassID, const char* Name, int IsStatic, puerts::CSharpFunctionCallback Callback, int64_t Data);
+    void LowMemoryNotification(v8::Isolate* Isolate);
+    void LogicTick(v8::Isolate* Isolate);
+    void SetLogCallback(LogCallback Log, LogCallback LogWarning, LogCallback LogError);
+
+    const v8::Value* GetArgumentValue(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, int Index);
+    double GetNumberFromValue(v8::Isolate* Isolate, v8::Value* Value, int IsOut);
+    const char* GetStringFromValue(v8::Isolate* Isolate, v8::Value* Value, int* Length, int IsOut);
+    const char* GetArrayBufferFromValue(v8::Isolate* Isolate, v8::Value* Value, int* Length, int IsOut);
+    void* GetObjectFromValue(v8::Isolate* Isolate, v8::Value* Value, int IsOut);
+    JSFunction* GetFunctionFromValue(v8::Isolate* Isolate, v8::Value* Value, int IsOut);
+    void ReleaseJSFunction(v8::Isolate* Isolate, JSFunction* Function);
+
+    void ReturnClass(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, int ClassID);
+    void ReturnObject(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, int ClassID, void* Ptr);
+    void ReturnNumber(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, double Number);
+    void ReturnString(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, const char* String);
+    void ReturnArrayBuffer(
+        v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, unsigned char* Bytes, int Length);
+
+    void PushNumberForJSFunction(JSFunction* Function, double D);
+    void PushStringForJSFunction(JSFunction* Function, const char* S);
+    FResultInfo* InvokeJSFunction(JSFunction* Function, int HasResult);
+    JSFunction* GetFunctionFromResult(FResultInfo* ResultInfo);
+}
+
+namespace
+{
+using FClock = std::chrono::steady_clock;
+
+struct FBenchPoint
+{
+    double X;
+    double Y;
+};
+
+struct FBenchResult
+{
+    std::string Name;
+    int64_t Operations;
+    double TotalMs;
+    int64_t Extra;
+    const char* ExtraName;
+};
+
+struct FBenchState
+{
+    v8::Isolate* Isolate = nullptr;
+    int PointClassID = -1;
+    int64_t Constructed = 0;
+    int64_t Destructed = 0;
+    double Sink = 0;
+    std::vector<FBenchPoint> PointPool;
+    std::vector<JSFunction*> PendingTimers;
+    std::string SmallString;
+    std::string LargeString;
+    std::vector<unsigned char> Buffer;
+};
+
+FBenchState GState;
+
+v8::Value* Arg(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, int Index)
+{
+    return const_cast<v8::Value*>(GetArgumentValue(Isolate, Info, Index));
+}
+
+void OnLog(const char* Msg)
+{
+    fprintf(stderr, "%s\n", Msg);
+}
+
+// ---- JS -> native 回调 ----
+
+void Nop(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+}
+
+// 逐个读取参数，使不同参数个数的开销可比
+void SumArgs(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    double Sum = 0;
+    for (int i = 0; i < ParamLen; ++i)
+    {
+        Sum += GetNumberFromValue(Isolate, Arg(Isolate, Info, i), false);
+    }
+    ReturnNumber(Isolate, Info, Sum);
+}
+
+void LoadPointClass(
+    v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    ReturnClass(Isolate, Info, GState.PointClassID);
+}
+
+void* ConstructPoint(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, int ParamLen, int64_t UserData)
+{
+    auto Point = new FBenchPoint();
+    Point->X = ParamLen > 0 ? GetNumberFromValue(Isolate, Arg(Isolate, Info, 0), false) : 0;
+    Point->Y = ParamLen > 1 ? GetNumberFromValue(Isolate, Arg(Isolate, Info, 1), false) : 0;
+    ++GState.Constructed;
+    return Point;
+}
+
+void DestructPoint(void* Self, int64_t UserData)
+{
+    delete static_cast<FBenchPoint*>(Self);
+    ++GState.Destructed;
+}
+
+void PointGetX(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    ReturnNumber(Isolate, Info, static_cast<FBenchPoint*>(Self)->X);
+}
+
+// 从对象池返回已有指针，测量纯包装（FindOrAddObject）开销，不涉及析构
+void GetPooledPoint(
+    v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    auto Index = static_cast<size_t>(GetNumberFromValue(Isolate, Arg(Isolate, Info, 0), false));
+    ReturnObject(Isolate, Info, GState.PointClassID, &GState.PointPool[Index % GState.PointPool.size()]);
+}
+
+void TakePoint(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    auto Point = static_cast<FBenchPoint*>(GetObjectFromValue(Isolate, Arg(Isolate, Info, 0), false));
+    GState.Sink += Point ? Point->X : 0;
+}
+
+void TakeString(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    int Length = 0;
+    GetStringFromValue(Isolate, Arg(Isolate, Info, 0), &Length, false);
+    GState.Sink += Length;
+}
+
+void ReturnSmallString(
+    v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    ReturnString(Isolate, Info, GState.SmallString.c_str());
+}
+
+void ReturnLargeString(
+    v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    ReturnString(Isolate, Info, GState.LargeString.c_str());
+}
+
+void TakeBuffer(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    int Length = 0;
+    auto Data = GetArrayBufferFromValue(Isolate, Arg(Isolate, Info, 0), &Length, false);
+    GState.Sink += Data && Length > 0 ? Data[Length - 1] : 0;
+}
+
+void ReturnBuffer(
+    v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    ReturnArrayBuffer(Isolate, Info, GState.Buffer.data(), static_cast<int>(GState.Buffer.size()));
+}
+
+// 模拟宿主侧定时器：JS 注册回调，由宿主循环触发后释放句柄
+void SetTimeout(v8::Isolate* Isolate, const v8::FunctionCallbackInfo<v8::Value>& Info, void* Self, int ParamLen, int64_t UserData)
+{
+    GState.PendingTimers.push_back(GetFunctionFromValue(Isolate, Arg(Isolate, Info, 0), false));
+}
+
+#if PUERTS_BENCH_FAST_CALL
+// ---- V8 fast API call ----
+// 参数形式与 V8FastCall.hpp 生成的包装一致，同一函数分别以带 CFunction 和不带 CFunction 注册，对比调用吞吐
+
+void SlowSumNumbers(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    auto Context = Info.GetIsolate()->GetCurrentContext();
+    Info.GetReturnValue().Set(Info[0]->NumberValue(Context).FromJust() + Info[1]->NumberValue(Context).FromJust());
+}
+
+double FastSumNumbers(v8::Local<v8::Object> Receiver, double A, double B)
+{
+    return A + B;
+}
+
+void SlowTakeObject(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    if (Info[0]->IsObject() && Info[0].As<v8::Object>()->InternalFieldCount() > 0)
+    {
+        auto Point = static_cast<FBenchPoint*>(Info[0].As<v8::Object>()->GetAlignedPointerFromInternalField(0));
+        GState.Sink += Point ? Point->X : 0;
+    }
+}
+
+void FastTakeObject(v8::Local<v8::Object> Receiver, v8::Local<v8::Value> Value, v8::FastApiCallbackOptions& Options)
+{
+    if (V8_UNLIKELY(!Value->IsObject() || Value.As<v8::Object>()->InternalFieldCount() == 0))
+    {
+        Options.fallback = true;
+        return;
+    }
+    auto Point = static_cast<FBenchPoint*>(Value.As<v8::Object>()->GetAlignedPointerFromInternalField(0));
+    GState.Sink += Point ? Point->X : 0;
+}
+
+#if V8_MAJOR_VERSION >= 10
+void SlowTakeString(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    GState.Sink += Info[0]->IsString() ? Info[0].As<v8::String>()->Utf8Length(Info.GetIsolate()) : 0;
+}
+
+void FastTakeString(v8::Local<v8::Object> Receiver, const v8::FastOneByteString& Str)
+{
+    GState.Sink += Str.length;
+}
+#endif
+
+#if V8_MAJOR_VERSION >= 11
+void SlowTakeBytes(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    if (Info[0]->IsUint8Array())
+    {
+        auto Array = Info[0].As<v8::Uint8Array>();
+        auto Length = Array->ByteLength();
+        auto Data = static_cast<const uint8_t*>(Array->Buffer()->GetBackingStore()->Data()) + Array->ByteOffset();
+        GState.Sink += Length > 0 ? Data[Length - 1] : 0;
+    }
+}
+
+void FastTakeBytes(
+    v8::Local<v8::Object> Receiver, const v8::FastApiTypedArray<uint8_t>& Array, v8::FastApiCallbackOptions& Options)
+{
+    uint8_t* Data = nullptr;
+    if (V8_UNLIKELY(!Array.getStorageIfAligned(&Data)))
+    {
+        Options.fallback = true;
+        return;
+    }
+    GState.Sink += Array.length() > 0 ? Data[Array.length() - 1] : 0;
+}
+#endif
+
+void SetFastGlobalFunction(v8::Isolate* Isolate, const char* Name, v8::FunctionCallback Slow, const v8::CFunction* Fast)
+{
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = JSEngine::Get(Isolate)->ResultInfo.Context.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+
+    auto Template = v8::FunctionTemplate::New(Isolate, Slow, v8::Local<v8::Value>(), v8::Local<v8::Signature>(), 0,
+        v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect, Fast);
+    Context->Global()
+        ->Set(Context, v8::String::NewFromUtf8(Isolate, Name).ToLocalChecked(), Template->GetFunction(Context).ToLocalChecked())
+        .Check();
+}
+
+void RegisterFastCallBindings(v8::Isolate* Isolate)
+{
+    static v8::CFunction SumInfo = v8::CFunction::Make(&FastSumNumbers);
+    SetFastGlobalFunction(Isolate, "__fastSum", &SlowSumNumbers, &SumInfo);
+    SetFastGlobalFunction(Isolate, "__slowSum", &SlowSumNumbers, nullptr);
+
+    static v8::CFunction ObjectInfo = v8::CFunction::Make(&FastTakeObject);
+    SetFastGlobalFunction(Isolate, "__fastTakeObject", &SlowTakeObject, &ObjectInfo);
+    SetFastGlobalFunction(Isolate, "__slowTakeObject", &SlowTakeObject, nullptr);
+
+#if V8_MAJOR_VERSION >= 10
+    static v8::CFunction StringInfo = v8::CFunction::Make(&FastTakeString);
+    SetFastGlobalFunction(Isolate, "__fastTakeString", &SlowTakeString, &StringInfo);
+    SetFastGlobalFunction(Isolate, "__slowTakeString", &SlowTakeString, nullptr);
+#endif
+
+#if V8_MAJOR_VERSION >= 11
+    static v8::CFunction BytesInfo = v8::CFunction::Make(&FastTakeBytes);
+    SetFastGlobalFunction(Isolate, "__fastTakeBytes", &SlowTakeBytes, &BytesInfo);
+    SetFastGlobalFunction(Isolate, "__slowTakeBytes", &SlowTakeBytes, nullptr);
+#endif
+}
+#endif
+
+// ---- 基准框架 ----
+
+class FBenchRunner
+{
+public:
+    FBenchRunner(int64_t InIterations, const char* InFilter) : Iterations(InIterations), Filter(InFilter)
+    {
+    }
+
+    bool Enabled(const char* Name) const
+    {
+        return Filter == nullptr || strstr(Name, Filter) != nullptr;
+    }
+
+    bool EvalScript(const std::string& Code, const char* Path)
+    {
+        if (Eval(GState.Isolate, Code.c_str(), Path) == nullptr)
+        {
+            int Length = 0;
+            fprintf(stderr, "[%s] %s\n", Path, GetLastExceptionInfo(GState.Isolate, &Length));
+            Failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    // 循环体在 JS 内执行，避免每次迭代都计入 Eval 的编译开销
+    void JsLoop(const char* Name, const char* Setup, const char* Body, int64_t Ops)
+    {
+        if (!Enabled(Name))
+            return;
+        std::string Code = std::string("(function(){") + Setup + "\nfor (let i = 0; i < " + std::to_string(Ops) + "; ++i) {" +
+                           Body + "}\n})();";
+        EvalScript(Code, "__bench_warmup.js");
+        auto Start = FClock::now();
+        if (!EvalScript(Code, Name))
+            return;
+        Add(Name, Ops, Start);
+    }
+
+    void Add(const char* Name, int64_t Ops, FClock::time_point Start, const char* ExtraName = nullptr, int64_t Extra = 0)
+    {
+        double Ms = std::chrono::duration<double, std::milli>(FClock::now() - Start).count();
+        Results.push_back({Name, Ops, Ms, Extra, ExtraName});
+    }
+
+    void Write(FILE* Out) const
+    {
+        fprintf(Out, "{\n  \"backend\": %d,\n  \"iterations\": %lld,\n  \"results\": [\n", GetLibBackend(GState.Isolate),
+            static_cast<long long>(Iterations));
+        for (size_t i = 0; i < Results.size(); ++i)
+        {
+            const auto& R = Results[i];
+            double NsPerOp = R.Operations > 0 ? R.TotalMs * 1e6 / R.Operations : 0;
+            fprintf(Out, "    {\"name\": \"%s\", \"ops\": %lld, \"total_ms\": %.3f, \"ns_per_op\": %.2f", R.Name.c_str(),
+                static_cast<long long>(R.Operations), R.TotalMs, NsPerOp);
+            if (R.ExtraName)
+            {
+                fprintf(Out, ", \"%s\": %lld", R.ExtraName, static_cast<long long>(R.Extra));
+            }
+            fprintf(Out, "}%s\n", i + 1 < Results.size() ? "," : "");
+        }
+        fprintf(Out, "  ]\n}\n");
+    }
+
+    int64_t Iterations;
+    const char* Filter;
+    bool Failed = false;
+    std::vector<FBenchResult> Results;
+};
+
+void RunCallBenchmarks(FBenchRunner& Runner)
+{
+    const int64_t N = Runner.Iterations;
+    Runner.JsLoop("js_loop_baseline", "let s = 0;", "s += i;", N);
+    Runner.JsLoop("js_to_native_nop", "", "__benchNop();", N);
+    Runner.JsLoop("js_to_native_arity_0", "", "__benchSum();", N);
+    Runner.JsLoop("js_to_native_arity_1", "", "__benchSum(i);", N);
+    Runner.JsLoop("js_to_native_arity_2", "", "__benchSum(i, 1);", N);
+    Runner.JsLoop("js_to_native_arity_4", "", "__benchSum(i, 1, 2, 3);", N);
+    Runner.JsLoop("js_to_native_arity_8", "", "__benchSum(i, 1, 2, 3, 4, 5, 6, 7);", N);
+
+    if (Runner.Enabled("native_to_js_arity"))
+    {
+        JSFunction* Add = GetFunctionFromResult(Eval(GState.Isolate, "(function(a, b) { return a + b; })", "__bench_add.js"));
+        JSFunction* StrLen = GetFunctionFromResult(Eval(GState.Isolate, "(function(s) { return s.length; })", "__bench_len.js"));
+
+        auto Start = FClock::now();
+        for (int64_t i = 0; i < N; ++i)
+        {
+            InvokeJSFunction(Add, 0);
+        }
+        Runner.Add("native_to_js_arity_0", N, Start);
+
+        Start = FClock::now();
+        for (int64_t i = 0; i < N; ++i)
+        {
+            PushNumberForJSFunction(Add, static_cast<double>(i));
+            PushNumberForJSFunction(Add, 1);
+            InvokeJSFunction(Add, 1);
+        }
+        Runner.Add("native_to_js_arity_2", N, Start);
+
+        Start = FClock::now();
+        for (int64_t i = 0; i < N; ++i)
+        {
+            PushStringForJSFunction(StrLen, GState.SmallString.c_str());
+            InvokeJSFunction(StrLen, 1);
+        }
+        Runner.Add("string_native_to_js_arg", N, Start);
+
+        ReleaseJSFunction(GState.Isolate, Add);
+        ReleaseJSFunction(GState.Isolate, StrLen);
+    }
+}
+
+void RunObjectBenchmarks(FBenchRunner& Runner)
+{
+    const int64_t N = Runner.Iterations;
+    const char* Setup = "const Point = __benchLoadPoint(); const p = new Point(1, 2);";
+    Runner.JsLoop("wrap_construct", "const Point = __benchLoadPoint();", "new Point(i, 1);", N);
+    Runner.JsLoop("wrap_return_pooled", "", "__benchPooledPoint(i);", N);
+    Runner.JsLoop("unwrap_method_self", Setup, "p.getX();", N);
+    Runner.JsLoop("unwrap_argument", Setup, "__benchTakePoint(p);", N);
+}
+
+void RunTransferBenchmarks(FBenchRunner& Runner)
+{
+    const int64_t N = Runner.Iterations;
+    Runner.JsLoop("string_js_to_native_64", "const s = 'x'.repeat(64);", "__benchTakeString(s);", N);
+    Runner.JsLoop("string_js_to_native_4k", "const s = 'x'.repeat(4096);", "__benchTakeString(s);", N / 10);
+    Runner.JsLoop("string_js_to_native_utf16_64", "const s = '\\u4e2d'.repeat(64);", "__benchTakeString(s);", N);
+    Runner.JsLoop("string_native_to_js_64", "", "__benchSmallString();", N);
+    Runner.JsLoop("string_native_to_js_4k", "", "__benchLargeString();", N / 10);
+    Runner.JsLoop("arraybuffer_js_to_native_4k", "const b = new ArrayBuffer(4096);", "__benchTakeBuffer(b);", N);
+    Runner.JsLoop("typedarray_js_to_native_4k", "const b = new Uint8Array(4096);", "__benchTakeBuffer(b);", N);
+    Runner.JsLoop("arraybuffer_native_to_js_4k", "", "__benchReturnBuffer();", N / 10);
+}
+
+void RunModuleBenchmarks(FBenchRunner& Runner)
+{
+    if (!Runner.Enabled("module_eval"))
+        return;
+    // 每次使用不同路径和源码，避免命中编译缓存；近似一个中等大小模块的编译加执行
+    const int64_t N = Runner.Iterations / 1000 > 0 ? Runner.Iterations / 1000 : 1;
+    std::string Body;
+    for (int i = 0; i < 64; ++i)
+    {
+        Body += "exports.f" + std::to_string(i) + " = function(a) { return a * " + std::to_string(i) + " + 1; };\n";
+    }
+    auto Start = FClock::now();
+    for (int64_t i = 0; i < N; ++i)
+    {
+        std::string Path = "bench/module_" + std::to_string(i) + ".js";
+        std::string Code = "(function(exports) {\n// " + Path + "\n" + Body + "return exports;\n})({});";
+        if (!Runner.EvalScript(Code, Path.c_str()))
+            return;
+    }
+    Runner.Add("module_eval_64_exports", N, Start);
+}
+
+void RunTimerBenchmarks(FBenchRunner& Runner)
+{
+    if (!Runner.Enabled("timer_churn"))
+        return;
+    // 16 条定时器链并发，每次触发都创建新的闭包并释放旧句柄
+    const int64_t N = Runner.Iterations / 10 > 0 ? Runner.Iterations / 10 : 1;
+    std::string Code = "(function(){ let left = " + std::to_string(N) +
+                       "; function tick() { if (--left > 0) __benchSetTimeout(() => tick()); }"
+                       " for (let i = 0; i < 16; ++i) __benchSetTimeout(() => tick()); })();";
+    auto Start = FClock::now();
+    if (!Runner.EvalScript(Code, "__bench_timer.js"))
+        return;
+    int64_t Fired = 0;
+    std::vector<JSFunction*> Ready;
+    while (!GState.PendingTimers.empty())
+    {
+        Ready.swap(GState.PendingTimers);
+        for (auto Timer : Ready)
+        {
+            InvokeJSFunction(Timer, 0);
+            ReleaseJSFunction(GState.Isolate, Timer);
+            ++Fired;
+        }
+        Ready.clear();
+        LogicTick(GState.Isolate);
+    }
+    Runner.Add("timer_churn", Fired, Start, "fired", Fired);
+}
+
+void RunGCBenchmarks(FBenchRunner& Runner)
+{
+    if (!Runner.Enabled("gc_wrapped"))
+        return;
+    const int64_t N = Runner.Iterations / 10 > 0 ? Runner.Iterations / 10 : 1;
+    LowMemoryNotification(GState.Isolate);
+    int64_t DestructedBefore = GState.Destructed;
+    std::string Code = "(function(){ const Point = __benchLoadPoint(); for (let i = 0; i < " + std::to_string(N) +
+                       "; ++i) new Point(i, i); })();";
+    if (!Runner.EvalScript(Code, "__bench_gc.js"))
+        return;
+    auto Start = FClock::now();
+    LowMemoryNotification(GState.Isolate);
+    Runner.Add("gc_wrapped_objects", N, Start, "collected", GState.Destructed - DestructedBefore);
+}
+
+void RunFastCallBenchmarks(FBenchRunner& Runner)
+{
+#if PUERTS_BENCH_FAST_CALL
+    // fast call 只在 TurboFan 优化后生效，JsLoop 先跑一遍预热
+    const int64_t N = Runner.Iterations;
+    const char* PointSetup = "const Point = __benchLoadPoint(); const p = new Point(1, 2);";
+    Runner.JsLoop("fastcall_slow_number_2", "", "__slowSum(i, 1);", N);
+    Runner.JsLoop("fastcall_fast_number_2", "", "__fastSum(i, 1);", N);
+    Runner.JsLoop("fastcall_slow_object", PointSetup, "__slowTakeObject(p);", N);
+    Runner.JsLoop("fastcall_fast_object", PointSetup, "__fastTakeObject(p);", N);
+#if V8_MAJOR_VERSION >= 10
+    Runner.JsLoop("fastcall_slow_string_64", "const s = 'x'.repeat(64);", "__slowTakeString(s);", N);
+    Runner.JsLoop("fastcall_fast_string_64", "const s = 'x'.repeat(64);", "__fastTakeString(s);", N);
+#endif
+#if V8_MAJOR_VERSION >= 11
+    Runner.JsLoop("fastcall_slow_uint8array_4k", "const b = new Uint8Array(4096);", "__slowTakeBytes(b);", N);
+    Runner.JsLoop("fastcall_fast_uint8array_4k", "const b = new Uint8Array(4096);", "__fastTakeBytes(b);", N);
+#endif
+#endif
+}
+
+void RegisterBindings(v8::Isolate* Isolate)
+{
+    SetGlobalFunction(Isolate, "__benchNop", &Nop, 0);
+    SetGlobalFunction(Isolate, "__benchSum", &SumArgs, 0);
+    SetGlobalFunction(Isolate, "__benchLoadPoint", &LoadPointClass, 0);
+    SetGlobalFunction(Isolate, "__benchPooledPoint", &GetPooledPoint, 0);
+    SetGlobalFunction(Isolate, "__benchTakePoint", &TakePoint, 0);
+    SetGlobalFunction(Isolate, "__benchTakeString", &TakeString, 0);
+    SetGlobalFunction(Isolate, "__benchSmallString", &ReturnSmallString, 0);
+    SetGlobalFunction(Isolate, "__benchLargeString", &ReturnLargeString, 0);
+    SetGlobalFunction(Isolate, "__benchTakeBuffer", &TakeBuffer, 0);
+    SetGlobalFunction(Isolate, "__benchReturnBuffer", &ReturnBuffer, 0);
+    SetGlobalFunction(Isolate, "__benchSetTimeout", &SetTimeout, 0);
+
+    GState.PointClassID = _RegisterClass(Isolate, -1, "BenchPoint", &ConstructPoint, &DestructPoint, 0);
+    RegisterFunction(Isolate, GState.PointClassID, "getX", 0, &PointGetX, 0);
+
+#if PUERTS_BENCH_FAST_CALL
+    RegisterFastCallBindings(Isolate);
+#endif
+}
+}    // namespace
+
+int main(int argc, char** argv)
+{
+    int64_t Iterations = 1000000;
+    const char* Filter = nullptr;
+    const char* OutPath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+        {
+            Iterations = strtoll(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            Filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            OutPath = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--iterations N] [--filter substring] [--out file.json]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (Iterations <= 0)
+    {
+        Iterations = 1;
+    }
+
+    SetLogCallback(&OnLog, &OnLog, &OnLog);
+#if PUERTS_BENCH_FAST_CALL
+    // 与 JsEnvModule 一致，这些 V8 版本默认不开启
+    v8::V8::SetFlagsFromString("--turbo-fast-api-calls");
+#endif
+    GState.Isolate = CreateJSEngine(0);
+    GState.PointPool.resize(1024);
+    GState.SmallString.assign(64, 'x');
+    GState.LargeString.assign(4096, 'x');
+    GState.Buffer.assign(4096, 1);
+    RegisterBindings(GState.Isolate);
+
+    FBenchRunner Runner(Iterations, Filter);
+    RunCallBenchmarks(Runner);
+    RunObjectBenchmarks(Runner);
+    RunTransferBenchmarks(Runner);
+    RunModuleBenchmarks(Runner);
+    RunTimerBenchmarks(Runner);
+    RunGCBenchmarks(Runner);
+    RunFastCallBenchmarks(Runner);
+
+    FILE* Out = OutPath ? fopen(OutPath, "w") : stdout;
+    if (Out == nullptr)
+    {
+        fprintf(stderr, "can not open %s\n", OutPath);
+        Out = stdout;
+    }
+    Runner.Write(Out);
+    if (Out != stdout)
+    {
+        fclose(Out);
+    }
+
+    DestroyJSEngine(GState.Isolate);
+    return Runner.Failed ? 1 : 0;
+}
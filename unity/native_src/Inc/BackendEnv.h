@@ -13,6 +13,9 @@
 #include "Common.h"
 #include "Log.h"
 #include "V8InspectorImpl.h"
+#include "CpuProfileRecorder.h"
+#include "IdleGCScheduler.h"
+#include "HeapLimitGuard.h"
 #if WITH_QUICKJS
 #include "quickjs-msvc.h"
 #endif
@@ -44,6 +47,9 @@ namespace PUERTS_NAMESPACE
         FBackendEnv()
         {
             Inspector = nullptr;
+            CpuProfileRecorder = nullptr;
+            IdleGCScheduler = nullptr;
+            HeapLimitGuard = nullptr;
         } 
 
         v8::Isolate::CreateParams* CreateParams;
@@ -132,13 +138,33 @@ namespace PUERTS_NAMESPACE
         // Inspector
         V8Inspector* Inspector;
 
+        // CpuProfiler
+        ICpuProfileRecorder* CpuProfileRecorder;
+
+        // Idle GC
+        FIdleGCScheduler* IdleGCScheduler;
+
+        // Heap limit
+        FHeapLimitGuard* HeapLimitGuard;
+
+        // 绑定层反复使用的属性名，缓存内部化后的字符串，属性查找时不再重复转换和查字符串表（QuickJS下为atom表）
+        // std::less<>可以直接用const char*查找，命中时不用构造std::string
+        std::map<std::string, v8::Global<v8::String>, std::less<>> PropertyNameCache;
+
+        // 超过该数量不再缓存，避免动态拼出的名字无限增长
+        static constexpr size_t MaxCachedPropertyNames = 4096;
+
+        v8::Local<v8::String> GetPropertyName(v8::Isolate* Isolate, const char* Name);
+
         V8_INLINE static FBackendEnv* Get(v8::Isolate* Isolate)
         {
             return (FBackendEnv*)Isolate->GetData(1);
         }
         static void GlobalPrepare();
 
-        void Initialize(void* external_quickjs_runtime, void* external_quickjs_context);
+        // 堆上限单位为字节，为0时使用引擎默认值
+        void Initialize(void* external_quickjs_runtime, void* external_quickjs_context, size_t MaxOldGenerationSizeInBytes = 0,
+            size_t MaxYoungGenerationSizeInBytes = 0);
 
         void UnInitialize();
         
@@ -148,6 +174,14 @@ namespace PUERTS_NAMESPACE
 
         bool InspectorTick();
 
+        bool StartCpuProfiling(v8::Isolate* Isolate, const char* Title, int SamplingIntervalUs);
+
+        bool StopCpuProfiling(v8::Isolate* Isolate, const char* Title, const char* OutputPath);
+
+        bool OnFrameIdle(v8::Isolate* Isolate, double IdleBudgetInSeconds);
+
+        std::string GetGCPauseReport();
+
         bool ClearModuleCache(v8::Isolate* Isolate, v8::Local<v8::Context> Context, const char* Path);
 
         std::string GetJSStackTrace();
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include "CommonTypes.h"
 
@@ -42,6 +43,10 @@ public:
     
     virtual void RequestFullGarbageCollectionForTesting() = 0;
 
+    virtual int OnFrameIdle(double IdleBudgetInSeconds) = 0;
+
+    virtual const char* GetGCPauseReport(int *Length) = 0;
+
 
     virtual void SetGeneralDestructor(FuncPtr GeneralDestructor) = 0;
 
@@ -193,6 +198,12 @@ public:
 
     virtual void LogicTick() = 0;
 
+    virtual int StartCpuProfiling(const char* Title, int SamplingIntervalUs) = 0;
+
+    virtual int StopCpuProfiling(const char* Title, const char* OutputPath) = 0;
+
+    virtual const char* GetBindingProfileReport(int MaxEntries, int *Length) = 0;
+
     //-------------------------- end debug --------------------------
     
     virtual ~IPuertsPlugin()
@@ -205,8 +216,19 @@ struct PuertsPluginStore
     IPuertsPlugin* PuertsPlugin;
 };
 
-IPuertsPlugin* CreateV8Plugin(void* external_quickjs_runtime, void* external_quickjs_context);
+IPuertsPlugin* CreateV8Plugin(void* external_quickjs_runtime, void* external_quickjs_context,
+    size_t MaxOldGenerationSizeInBytes = 0, size_t MaxYoungGenerationSizeInBytes = 0);
+
+IPuertsPlugin* CreateQJSPlugin(void* external_quickjs_runtime, void* external_quickjs_context,
+    size_t MaxOldGenerationSizeInBytes = 0, size_t MaxYoungGenerationSizeInBytes = 0);
+
+// binding profiler is per backend library, not per plugin instance
+void SetV8BindingProfilerEnabled(bool Enabled);
+
+void ResetV8BindingProfiler();
+
+void SetQJSBindingProfilerEnabled(bool Enabled);
 
-IPuertsPlugin* CreateQJSPlugin(void* external_quickjs_runtime, void* external_quickjs_context);
+void ResetQJSBindingProfiler();
 
 }
\ No newline at end of file
@@ -82,9 +82,11 @@ private:
 #endif
 public:
 #ifdef MULT_BACKENDS
-    JSEngine(puerts::IPuertsPlugin* InPuertsPlugin, void* external_quickjs_runtime, void* external_quickjs_context);
+    JSEngine(puerts::IPuertsPlugin* InPuertsPlugin, void* external_quickjs_runtime, void* external_quickjs_context,
+        size_t MaxOldGenerationSizeInBytes = 0, size_t MaxYoungGenerationSizeInBytes = 0);
 #else
-    JSEngine(void* external_quickjs_runtime, void* external_quickjs_context);
+    JSEngine(void* external_quickjs_runtime, void* external_quickjs_context, size_t MaxOldGenerationSizeInBytes = 0,
+        size_t MaxYoungGenerationSizeInBytes = 0);
 #endif
 
     ~JSEngine();
@@ -261,7 +261,8 @@ void FBackendEnv::GlobalPrepare()
     }
 }
 
-void FBackendEnv::Initialize(void* external_quickjs_runtime, void* external_quickjs_context)
+void FBackendEnv::Initialize(void* external_quickjs_runtime, void* external_quickjs_context, size_t MaxOldGenerationSizeInBytes,
+    size_t MaxYoungGenerationSizeInBytes)
 {
 #if defined(WITH_NODEJS)
     const int Ret = uv_loop_init(&NodeUVLoop);
@@ -278,6 +279,10 @@ void FBackendEnv::Initialize(void* external_quickjs_runtime, void* external_quic
     auto Platform = static_cast<node::MultiIsolatePlatform*>(GPlatform.get());
     MainIsolate = node::NewIsolate(NodeArrayBufferAllocator.get(), &NodeUVLoop,
         Platform);
+    if (MaxOldGenerationSizeInBytes > 0 || MaxYoungGenerationSizeInBytes > 0)
+    {
+        puerts::PLog(puerts::Warning, "heap budget is not supported by nodejs backend, use --max-old-space-size instead");
+    }
 
     MainIsolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kAuto);
 #else
@@ -288,9 +293,18 @@ void FBackendEnv::Initialize(void* external_quickjs_runtime, void* external_quic
     
 #if WITH_QUICKJS
     MainIsolate = (external_quickjs_runtime == nullptr) ? v8::Isolate::New(*CreateParams) : v8::Isolate::New(external_quickjs_runtime);
+    // QuickJS超出上限时抛出out of memory异常，只影响当前执行
+    if (external_quickjs_runtime == nullptr && (MaxOldGenerationSizeInBytes > 0 || MaxYoungGenerationSizeInBytes > 0))
+    {
+        JS_SetMemoryLimit(MainIsolate->runtime_, MaxOldGenerationSizeInBytes + MaxYoungGenerationSizeInBytes);
+    }
 #else
+    FHeapLimitGuard::ApplyHeapBudget(CreateParams->constraints, MaxOldGenerationSizeInBytes, MaxYoungGenerationSizeInBytes);
     MainIsolate = v8::Isolate::New(*CreateParams);
 #endif
+#endif
+#if !WITH_QUICKJS
+    HeapLimitGuard = new FHeapLimitGuard(MainIsolate);
 #endif
 
     auto Isolate = MainIsolate;
@@ -387,6 +401,23 @@ void FBackendEnv::UnInitialize()
     // }, &platform_finished);
     Platform->UnregisterIsolate(MainIsolate);
 #endif
+    if (CpuProfileRecorder)
+    {
+        v8::Isolate::Scope IsolateScope(MainIsolate);
+        delete CpuProfileRecorder;
+        CpuProfileRecorder = nullptr;
+    }
+    if (IdleGCScheduler)
+    {
+        delete IdleGCScheduler;
+        IdleGCScheduler = nullptr;
+    }
+    if (HeapLimitGuard)
+    {
+        delete HeapLimitGuard;
+        HeapLimitGuard = nullptr;
+    }
+    PropertyNameCache.clear();
     MainContext.Reset();
     MainIsolate->Dispose();
     MainIsolate = nullptr;
@@ -407,6 +438,18 @@ void FBackendEnv::UnInitialize()
 
 void FBackendEnv::LogicTick()
 {
+    if (HeapLimitGuard)
+    {
+#ifdef THREAD_SAFE
+        v8::Locker Locker(MainIsolate);
+#endif
+        v8::Isolate::Scope IsolateScope(MainIsolate);
+        std::string HeapLimitReport;
+        if (HeapLimitGuard->ProcessPending(HeapLimitReport))
+        {
+            puerts::PLog(puerts::Error, "%s", HeapLimitReport.c_str());
+        }
+    }
 #if WITH_NODEJS
 #ifdef THREAD_SAFE
     v8::Locker Locker(MainIsolate);
@@ -463,6 +506,75 @@ bool FBackendEnv::InspectorTick()
     return true;
 }
 
+bool FBackendEnv::StartCpuProfiling(v8::Isolate* Isolate, const char* Title, int SamplingIntervalUs)
+{
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    if (CpuProfileRecorder == nullptr)
+    {
+        CpuProfileRecorder = CreateCpuProfileRecorder(Isolate);
+        if (CpuProfileRecorder == nullptr)
+        {
+            puerts::PLog(puerts::Warning, "cpu profiling is not supported by current backend");
+            return false;
+        }
+    }
+    return CpuProfileRecorder->Start(Title, SamplingIntervalUs);
+}
+
+bool FBackendEnv::StopCpuProfiling(v8::Isolate* Isolate, const char* Title, const char* OutputPath)
+{
+    if (CpuProfileRecorder == nullptr)
+    {
+        return false;
+    }
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    if (!CpuProfileRecorder->Stop(Title, OutputPath))
+    {
+        puerts::PLog(puerts::Error, "stop cpu profiling [%s] fail, output: %s", Title, OutputPath);
+        return false;
+    }
+    return true;
+}
+
+bool FBackendEnv::OnFrameIdle(v8::Isolate* Isolate, double IdleBudgetInSeconds)
+{
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    if (IdleGCScheduler == nullptr)
+    {
+        IdleGCScheduler = new FIdleGCScheduler(Isolate, GPlatform.get());
+    }
+    return IdleGCScheduler->OnFrameIdle(IdleBudgetInSeconds);
+}
+
+std::string FBackendEnv::GetGCPauseReport()
+{
+    return IdleGCScheduler ? IdleGCScheduler->GetPauseReport() : std::string();
+}
+
+v8::Local<v8::String> FBackendEnv::GetPropertyName(v8::Isolate* Isolate, const char* Name)
+{
+    auto Iter = PropertyNameCache.lower_bound(Name);
+    if (Iter != PropertyNameCache.end() && Iter->first == Name)
+    {
+        return Iter->second.Get(Isolate);
+    }
+    v8::Local<v8::String> Str = v8::String::NewFromUtf8(Isolate, Name, v8::NewStringType::kInternalized).ToLocalChecked();
+    if (PropertyNameCache.size() < MaxCachedPropertyNames)
+    {
+        PropertyNameCache.emplace_hint(Iter, Name, v8::Global<v8::String>(Isolate, Str));
+    }
+    return Str;
+}
+
 bool FBackendEnv::ClearModuleCache(v8::Isolate* Isolate, v8::Local<v8::Context> Context, const char* Path)
 {
     std::string key(Path);
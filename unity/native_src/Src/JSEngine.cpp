@@ -92,15 +92,18 @@ namespace PUERTS_NAMESPACE
     }
 
 #ifdef MULT_BACKENDS
-    JSEngine::JSEngine(puerts::IPuertsPlugin* InPuertsPlugin, void* external_quickjs_runtime, void* external_quickjs_context)
+    JSEngine::JSEngine(puerts::IPuertsPlugin* InPuertsPlugin, void* external_quickjs_runtime, void* external_quickjs_context,
+        size_t MaxOldGenerationSizeInBytes, size_t MaxYoungGenerationSizeInBytes)
 #else
-    JSEngine::JSEngine(void* external_quickjs_runtime, void* external_quickjs_context)
+    JSEngine::JSEngine(void* external_quickjs_runtime, void* external_quickjs_context, size_t MaxOldGenerationSizeInBytes,
+        size_t MaxYoungGenerationSizeInBytes)
 #endif
     {
         GeneralDestructor = nullptr;
         FBackendEnv::GlobalPrepare();
 
-        BackendEnv.Initialize(external_quickjs_runtime, external_quickjs_context);
+        BackendEnv.Initialize(external_quickjs_runtime, external_quickjs_context, MaxOldGenerationSizeInBytes,
+            MaxYoungGenerationSizeInBytes);
         MainIsolate = BackendEnv.MainIsolate;
 
         auto Isolate = MainIsolate;
@@ -110,6 +113,16 @@ namespace PUERTS_NAMESPACE
         ResultInfo.Isolate = Isolate;
         Isolate->SetData(0, this);
         Isolate->SetData(1, &BackendEnv);
+        if (BackendEnv.HeapLimitGuard)
+        {
+            // 接近堆上限时释放属性名缓存、最近一次的异常和字符串缓冲区
+            BackendEnv.HeapLimitGuard->SetCleanupCallback([this]()
+            {
+                BackendEnv.PropertyNameCache.clear();
+                LastException.Reset();
+                std::vector<char>().swap(StrBuffer);
+            });
+        }
 
 #ifdef THREAD_SAFE
         v8::Locker Locker(Isolate);
@@ -363,7 +376,7 @@ namespace PUERTS_NAMESPACE
     JSFunction* JSEngine::CreateJSFunction(v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Function> InFunction)
     {
         std::lock_guard<std::mutex> guard(JSFunctionsMutex);
-        auto maybeId = InFunction->Get(InContext, FV8Utils::V8String(InIsolate, FUNCTION_INDEX_KEY));
+        auto maybeId = InFunction->Get(InContext, BackendEnv.GetPropertyName(InIsolate, FUNCTION_INDEX_KEY));
         if (!maybeId.IsEmpty()) {
             auto id = maybeId.ToLocalChecked();
             if (id->IsNumber()) {
@@ -391,7 +404,7 @@ namespace PUERTS_NAMESPACE
 #endif
             JSFunctions.push_back(Function);
         }
-        InFunction->Set(InContext, FV8Utils::V8String(InIsolate, FUNCTION_INDEX_KEY), v8::Integer::New(InIsolate, Function->Index));
+        InFunction->Set(InContext, BackendEnv.GetPropertyName(InIsolate, FUNCTION_INDEX_KEY), v8::Integer::New(InIsolate, Function->Index));
         return Function;
     }
 
@@ -545,11 +558,11 @@ namespace PUERTS_NAMESPACE
 
         if (IsStatic)
         {
-            Templates[ClassID].Get(Isolate)->Set(FV8Utils::V8String(Isolate, Name), ToTemplate(Isolate, IsStatic, Callback, Data));
+            Templates[ClassID].Get(Isolate)->Set(BackendEnv.GetPropertyName(Isolate, Name), ToTemplate(Isolate, IsStatic, Callback, Data));
         }
         else
         {
-            Templates[ClassID].Get(Isolate)->PrototypeTemplate()->Set(FV8Utils::V8String(Isolate, Name), ToTemplate(Isolate, IsStatic, Callback, Data));
+            Templates[ClassID].Get(Isolate)->PrototypeTemplate()->Set(BackendEnv.GetPropertyName(Isolate, Name), ToTemplate(Isolate, IsStatic, Callback, Data));
         }
 
         return true;
@@ -590,12 +603,12 @@ namespace PUERTS_NAMESPACE
 
         if (IsStatic)
         {
-            Templates[ClassID].Get(Isolate)->SetAccessorProperty(FV8Utils::V8String(Isolate, Name), ToTemplate(Isolate, IsStatic, Getter, GetterData)
+            Templates[ClassID].Get(Isolate)->SetAccessorProperty(BackendEnv.GetPropertyName(Isolate, Name), ToTemplate(Isolate, IsStatic, Getter, GetterData)
                 , Setter == nullptr ? v8::Local<v8::FunctionTemplate>() : ToTemplate(Isolate, IsStatic, Setter, SetterData), Attr);
         }
         else
         {
-            Templates[ClassID].Get(Isolate)->PrototypeTemplate()->SetAccessorProperty(FV8Utils::V8String(Isolate, Name),
+            Templates[ClassID].Get(Isolate)->PrototypeTemplate()->SetAccessorProperty(BackendEnv.GetPropertyName(Isolate, Name),
                 ToTemplate(Isolate, IsStatic, Getter, GetterData)
                 , Setter == nullptr ? v8::Local<v8::FunctionTemplate>() : ToTemplate(Isolate, IsStatic, Setter, SetterData), Attr);
         }
@@ -611,7 +624,7 @@ namespace PUERTS_NAMESPACE
         auto Context = Isolate->GetCurrentContext();
 
         auto Result = Templates[ClassID].Get(Isolate)->GetFunction(Context).ToLocalChecked();
-        Result->Set(Context, FV8Utils::V8String(Isolate, "__puertsMetadata"), Metadatas[ClassID].Get(Isolate));
+        Result->Set(Context, BackendEnv.GetPropertyName(Isolate, "__puertsMetadata"), Metadatas[ClassID].Get(Isolate));
         return Result;
     }
 
@@ -8,9 +8,24 @@
 #include "JSFunction.h"
 #include "V8Utils.h"
 #include "JSEngine.h"
+#include "BindingProfiler.h"
 
 namespace PUERTS_NAMESPACE
 {
+    static const char* GetJSFunctionProfileName(const void* Key)
+    {
+        thread_local std::string Name;
+        auto Function = static_cast<const JSFunction*>(Key);
+#if !defined(WITH_QUICKJS)
+        v8::Isolate* Isolate = Function->ResultInfo.Isolate;
+        v8::String::Utf8Value DebugName(Isolate, Function->GFunction.Get(Isolate)->GetDebugName());
+        Name = (*DebugName && DebugName.length() > 0) ? *DebugName : "(anonymous)";
+#else
+        Name = "JSFunction#" + std::to_string(Function->Index);
+#endif
+        return Name.c_str();
+    }
+
     JSObject::JSObject(v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Object> InObject, int32_t InIndex) 
     {
         Isolate = InIsolate;
@@ -41,6 +56,7 @@ namespace PUERTS_NAMESPACE
 
     JSFunction::~JSFunction()
     {
+        FBindingProfiler::NotifyKeyReleased(this);
         v8::Isolate* Isolate = ResultInfo.Isolate;
 #ifdef THREAD_SAFE
         v8::Locker Locker(Isolate);
@@ -103,6 +119,7 @@ namespace PUERTS_NAMESPACE
         v8::HandleScope HandleScope(Isolate);
         v8::Local<v8::Context> Context = ResultInfo.Context.Get(Isolate);
         v8::Context::Scope ContextScope(Context);
+        FBindingCallScope ProfileScope(this, &GetJSFunctionProfileName);
 
         std::vector< v8::Local<v8::Value>> V8Args;
         for (int i = 0; i < Arguments.size(); ++i)
@@ -112,7 +129,9 @@ namespace PUERTS_NAMESPACE
         }
         Arguments.clear();
         v8::TryCatch TryCatch(Isolate);
+        FBindingCallScope::BeginTargetCall();
         auto maybeValue = GFunction.Get(Isolate)->Call(Context, Context->Global(), static_cast<int>(V8Args.size()), V8Args.data());
+        FBindingCallScope::EndTargetCall();
         
         if (TryCatch.HasCaught())
         {
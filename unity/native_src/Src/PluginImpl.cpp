@@ -7,6 +7,7 @@
 
 #include "IPuertsPlugin.h"
 #include "JSEngine.h"
+#include "BindingProfiler.h"
 
 namespace PUERTS_NAMESPACE
 {
@@ -14,8 +15,10 @@ namespace PUERTS_NAMESPACE
 class V8Plugin : public puerts::IPuertsPlugin
 {
 public:
-    V8Plugin(void* external_quickjs_runtime, void* external_quickjs_context)
-        : jsEngine(this, external_quickjs_runtime, external_quickjs_context)
+    V8Plugin(void* external_quickjs_runtime, void* external_quickjs_context, size_t MaxOldGenerationSizeInBytes = 0,
+        size_t MaxYoungGenerationSizeInBytes = 0)
+        : jsEngine(this, external_quickjs_runtime, external_quickjs_context, MaxOldGenerationSizeInBytes,
+              MaxYoungGenerationSizeInBytes)
     {
     }
     
@@ -49,6 +52,10 @@ public:
     
     virtual void RequestFullGarbageCollectionForTesting() override;
 
+    virtual int OnFrameIdle(double IdleBudgetInSeconds) override;
+
+    virtual const char* GetGCPauseReport(int *Length) override;
+
 
     virtual void SetGeneralDestructor(puerts::FuncPtr GeneralDestructor) override;
 
@@ -200,6 +207,12 @@ public:
 
     virtual void LogicTick() override;
 
+    virtual int StartCpuProfiling(const char* Title, int SamplingIntervalUs) override;
+
+    virtual int StopCpuProfiling(const char* Title, const char* OutputPath) override;
+
+    virtual const char* GetBindingProfileReport(int MaxEntries, int *Length) override;
+
     //-------------------------- end debug --------------------------
     
 private:
@@ -284,6 +297,20 @@ void V8Plugin::RequestFullGarbageCollectionForTesting()
     jsEngine.RequestFullGarbageCollectionForTesting();
 }
 
+int V8Plugin::OnFrameIdle(double IdleBudgetInSeconds)
+{
+    return jsEngine.BackendEnv.OnFrameIdle(jsEngine.MainIsolate, IdleBudgetInSeconds) ? 1 : 0;
+}
+
+const char* V8Plugin::GetGCPauseReport(int *Length)
+{
+    std::string Report = jsEngine.BackendEnv.GetGCPauseReport();
+    *Length = static_cast<int>(Report.length());
+    jsEngine.StrBuffer.resize(Report.length() + 1);
+    memcpy(jsEngine.StrBuffer.data(), Report.c_str(), Report.length() + 1);
+    return jsEngine.StrBuffer.data();
+}
+
 void V8Plugin::SetGeneralDestructor(puerts::FuncPtr GeneralDestructor)
 {
     jsEngine.GeneralDestructor = (PUERTS_NAMESPACE::CSharpDestructorCallback)GeneralDestructor;
@@ -1197,6 +1224,25 @@ void V8Plugin::LogicTick()
     return jsEngine.LogicTick();
 }
 
+int V8Plugin::StartCpuProfiling(const char* Title, int SamplingIntervalUs)
+{
+    return jsEngine.BackendEnv.StartCpuProfiling(jsEngine.MainIsolate, Title, SamplingIntervalUs) ? 1 : 0;
+}
+
+int V8Plugin::StopCpuProfiling(const char* Title, const char* OutputPath)
+{
+    return jsEngine.BackendEnv.StopCpuProfiling(jsEngine.MainIsolate, Title, OutputPath) ? 1 : 0;
+}
+
+const char* V8Plugin::GetBindingProfileReport(int MaxEntries, int *Length)
+{
+    std::string Report = PUERTS_NAMESPACE::FBindingProfiler::ToJson(MaxEntries > 0 ? static_cast<size_t>(MaxEntries) : 0);
+    *Length = static_cast<int>(Report.length());
+    jsEngine.StrBuffer.resize(Report.length() + 1);
+    memcpy(jsEngine.StrBuffer.data(), Report.c_str(), Report.length() + 1);
+    return jsEngine.StrBuffer.data();
+}
+
 //-------------------------- end debug --------------------------
 
 }
@@ -1204,16 +1250,40 @@ void V8Plugin::LogicTick()
 namespace puerts
 {
 #ifdef V8_BACKEND
-    IPuertsPlugin* CreateV8Plugin(void* external_quickjs_runtime, void* external_quickjs_context)
+    IPuertsPlugin* CreateV8Plugin(void* external_quickjs_runtime, void* external_quickjs_context,
+        size_t MaxOldGenerationSizeInBytes, size_t MaxYoungGenerationSizeInBytes)
     {
-        return new PUERTS_NAMESPACE::V8Plugin(external_quickjs_runtime, external_quickjs_context);
+        return new PUERTS_NAMESPACE::V8Plugin(external_quickjs_runtime, external_quickjs_context, MaxOldGenerationSizeInBytes,
+            MaxYoungGenerationSizeInBytes);
+    }
+
+    void SetV8BindingProfilerEnabled(bool Enabled)
+    {
+        PUERTS_NAMESPACE::FBindingProfiler::SetEnabled(Enabled);
+    }
+
+    void ResetV8BindingProfiler()
+    {
+        PUERTS_NAMESPACE::FBindingProfiler::Reset();
     }
 #endif
 
 #ifdef QJS_BACKEND
-    IPuertsPlugin* CreateQJSPlugin(void* external_quickjs_runtime, void* external_quickjs_context)
+    IPuertsPlugin* CreateQJSPlugin(void* external_quickjs_runtime, void* external_quickjs_context,
+        size_t MaxOldGenerationSizeInBytes, size_t MaxYoungGenerationSizeInBytes)
+    {
+        return new PUERTS_NAMESPACE::V8Plugin(external_quickjs_runtime, external_quickjs_context, MaxOldGenerationSizeInBytes,
+            MaxYoungGenerationSizeInBytes);
+    }
+
+    void SetQJSBindingProfilerEnabled(bool Enabled)
+    {
+        PUERTS_NAMESPACE::FBindingProfiler::SetEnabled(Enabled);
+    }
+
+    void ResetQJSBindingProfiler()
     {
-        return new PUERTS_NAMESPACE::V8Plugin(external_quickjs_runtime, external_quickjs_context);
+        PUERTS_NAMESPACE::FBindingProfiler::Reset();
     }
 #endif
 }
\ No newline at end of file
@@ -6,8 +6,10 @@
 */
 #include "JSEngine.h"
 #include <cstring>
+#include <algorithm>
 #include "V8Utils.h"
 #include "Log.h"
+#include "BindingProfiler.h"
 
 #define API_LEVEL 34
 
@@ -54,6 +56,14 @@ V8_EXPORT v8::Isolate *CreateJSEngine(int backend)
     return JsEngine->MainIsolate;
 }
 
+// 堆上限单位为MB，为0时使用引擎默认值
+V8_EXPORT v8::Isolate *CreateJSEngineWithHeapBudget(int backend, int MaxOldGenerationSizeMB, int MaxYoungGenerationSizeMB)
+{
+    auto JsEngine = new JSEngine(nullptr, nullptr, static_cast<size_t>(std::max(MaxOldGenerationSizeMB, 0)) * 1024 * 1024,
+        static_cast<size_t>(std::max(MaxYoungGenerationSizeMB, 0)) * 1024 * 1024);
+    return JsEngine->MainIsolate;
+}
+
 V8_EXPORT v8::Isolate *CreateJSEngineWithExternalEnv(int backend, void* external_quickjs_runtime, void* external_quickjs_context)
 {
 #if WITH_QUICKJS
@@ -981,6 +991,54 @@ V8_EXPORT void LogicTick(v8::Isolate *Isolate)
     return JsEngine->LogicTick();
 }
 
+V8_EXPORT int OnFrameIdle(v8::Isolate *Isolate, double IdleBudgetInSeconds)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    return JsEngine->BackendEnv.OnFrameIdle(Isolate, IdleBudgetInSeconds) ? 1 : 0;
+}
+
+V8_EXPORT const char* GetGCPauseReport(v8::Isolate* Isolate, int* Length)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    std::string Report = JsEngine->BackendEnv.GetGCPauseReport();
+    *Length = static_cast<int>(Report.length());
+    JsEngine->StrBuffer.resize(Report.length() + 1);
+    memcpy(JsEngine->StrBuffer.data(), Report.c_str(), Report.length() + 1);
+    return JsEngine->StrBuffer.data();
+}
+
+V8_EXPORT int StartCpuProfiling(v8::Isolate *Isolate, const char* Title, int SamplingIntervalUs)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    return JsEngine->BackendEnv.StartCpuProfiling(Isolate, Title, SamplingIntervalUs) ? 1 : 0;
+}
+
+V8_EXPORT int StopCpuProfiling(v8::Isolate *Isolate, const char* Title, const char* OutputPath)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    return JsEngine->BackendEnv.StopCpuProfiling(Isolate, Title, OutputPath) ? 1 : 0;
+}
+
+V8_EXPORT void SetBindingProfilerEnabled(int Enabled)
+{
+    puerts::FBindingProfiler::SetEnabled(Enabled != 0);
+}
+
+V8_EXPORT void ResetBindingProfiler()
+{
+    puerts::FBindingProfiler::Reset();
+}
+
+V8_EXPORT const char* GetBindingProfileReport(v8::Isolate* Isolate, int MaxEntries, int* Length)
+{
+    auto JsEngine = FV8Utils::IsolateData<JSEngine>(Isolate);
+    std::string Report = puerts::FBindingProfiler::ToJson(MaxEntries > 0 ? static_cast<size_t>(MaxEntries) : 0);
+    *Length = static_cast<int>(Report.length());
+    JsEngine->StrBuffer.resize(Report.length() + 1);
+    memcpy(JsEngine->StrBuffer.data(), Report.c_str(), Report.length() + 1);
+    return JsEngine->StrBuffer.data();
+}
+
 V8_EXPORT void SetLogCallback(LogCallback Log, LogCallback LogWarning, LogCallback LogError)
 {
     GLogCallback = Log;
@@ -76,6 +76,26 @@ PUERTS_EXPORT puerts::IPuertsPlugin* CreateJSEngine(int backend)
     return nullptr;
 }
 
+PUERTS_EXPORT puerts::IPuertsPlugin* CreateJSEngineWithHeapBudget(int backend, int MaxOldGenerationSizeMB, int MaxYoungGenerationSizeMB)
+{
+    size_t MaxOld = static_cast<size_t>(MaxOldGenerationSizeMB > 0 ? MaxOldGenerationSizeMB : 0) * 1024 * 1024;
+    size_t MaxYoung = static_cast<size_t>(MaxYoungGenerationSizeMB > 0 ? MaxYoungGenerationSizeMB : 0) * 1024 * 1024;
+#ifdef V8_BACKEND
+    if (0 == backend)
+    {
+        return puerts::CreateV8Plugin(nullptr, nullptr, MaxOld, MaxYoung);
+    }
+#endif
+
+#ifdef QJS_BACKEND
+    if (2 == backend)
+    {
+        return puerts::CreateQJSPlugin(nullptr, nullptr, MaxOld, MaxYoung);
+    }
+#endif
+    return nullptr;
+}
+
 PUERTS_EXPORT puerts::IPuertsPlugin* CreateJSEngineWithExternalEnv(int backend, void* external_quickjs_runtime, void* external_quickjs_context)
 {
 #if QJS_BACKEND
@@ -161,6 +181,16 @@ PUERTS_EXPORT void RequestFullGarbageCollectionForTesting(puerts::IPuertsPlugin*
     plugin->RequestFullGarbageCollectionForTesting();
 }
 
+PUERTS_EXPORT int OnFrameIdle(puerts::IPuertsPlugin* plugin, double IdleBudgetInSeconds)
+{
+    return plugin->OnFrameIdle(IdleBudgetInSeconds);
+}
+
+PUERTS_EXPORT const char* GetGCPauseReport(puerts::IPuertsPlugin* plugin, int *Length)
+{
+    return plugin->GetGCPauseReport(Length);
+}
+
 PUERTS_EXPORT void SetGeneralDestructor(puerts::IPuertsPlugin* plugin, puerts::FuncPtr GeneralDestructor)
 {
     plugin->SetGeneralDestructor(GeneralDestructor);
@@ -514,6 +544,41 @@ PUERTS_EXPORT void LogicTick(puerts::IPuertsPlugin* plugin)
     return plugin->LogicTick();
 }
 
+PUERTS_EXPORT int StartCpuProfiling(puerts::IPuertsPlugin* plugin, const char* Title, int SamplingIntervalUs)
+{
+    return plugin->StartCpuProfiling(Title, SamplingIntervalUs);
+}
+
+PUERTS_EXPORT int StopCpuProfiling(puerts::IPuertsPlugin* plugin, const char* Title, const char* OutputPath)
+{
+    return plugin->StopCpuProfiling(Title, OutputPath);
+}
+
+PUERTS_EXPORT void SetBindingProfilerEnabled(int Enabled)
+{
+#ifdef V8_BACKEND
+    puerts::SetV8BindingProfilerEnabled(Enabled != 0);
+#endif
+#ifdef QJS_BACKEND
+    puerts::SetQJSBindingProfilerEnabled(Enabled != 0);
+#endif
+}
+
+PUERTS_EXPORT void ResetBindingProfiler()
+{
+#ifdef V8_BACKEND
+    puerts::ResetV8BindingProfiler();
+#endif
+#ifdef QJS_BACKEND
+    puerts::ResetQJSBindingProfiler();
+#endif
+}
+
+PUERTS_EXPORT const char* GetBindingProfileReport(puerts::IPuertsPlugin* plugin, int MaxEntries, int *Length)
+{
+    return plugin->GetBindingProfileReport(MaxEntries, Length);
+}
+
 PUERTS_EXPORT void SetLogCallback(LogCallback Log, LogCallback LogWarning, LogCallback LogError)
 {
     GLogCallback = Log;
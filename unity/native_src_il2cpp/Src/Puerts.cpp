@@ -19,8 +19,10 @@
 #include "JSClassRegister.h"
 #include "Binding.hpp"   
 #include <stdarg.h>
+#include <algorithm>
 #include "BackendEnv.h"
 #include "ExecuteModuleJSCode.h"
+#include "BindingProfiler.h"
 
 #define USE_OUTSIZE_UNITY 1
 
@@ -46,6 +48,9 @@ static LogCallback GLogCallback = nullptr;
 
 static UnityExports GUnityExports;
 
+// ExchangeAPI传入的il2cpp侧结构，开关绑定统计时需要同步修改
+static UnityExports* GExchangedExports = nullptr;
+
 typedef void (*LazyLoadTypeFunc) (const void* typeId, bool includeNonPublic, void* method);
 
 void* GTryLoadTypeMethodInfo = nullptr;
@@ -312,7 +317,8 @@ static void* GetJSObjectValue(const PersistentObjectInfo* objectInfo, const char
     auto LocalContext = objectInfo->EnvInfo->Context.Get(Isolate);
     v8::Context::Scope ContextScope(LocalContext);
 
-    v8::Local<v8::Value> Key = v8::String::NewFromUtf8(Isolate, key).ToLocalChecked();
+    // key由用户代码给出，数量不可控，不进属性名缓存
+    v8::Local<v8::Value> Key = v8::String::NewFromUtf8(Isolate, key, v8::NewStringType::kInternalized).ToLocalChecked();
 
     v8::Local<v8::Object> Obj = v8::Local<v8::Object>::Cast(objectInfo->JsObject.Get(Isolate));
 
@@ -701,7 +707,7 @@ FieldWrapFuncInfo * FindFieldWrapFuncInfo(const char* signature)
 
 struct JSEnv
 {
-    JSEnv()
+    JSEnv(size_t MaxOldGenerationSizeInBytes = 0, size_t MaxYoungGenerationSizeInBytes = 0)
     {
         puerts::FBackendEnv::GlobalPrepare();
         
@@ -716,7 +722,7 @@ struct JSEnv
 #endif
         v8::V8::SetFlagsFromString(Flags.c_str(), static_cast<int>(Flags.size()));
         
-        BackendEnv.Initialize(nullptr, nullptr);
+        BackendEnv.Initialize(nullptr, nullptr, MaxOldGenerationSizeInBytes, MaxYoungGenerationSizeInBytes);
         MainIsolate = BackendEnv.MainIsolate;
 
         auto Isolate = MainIsolate;
@@ -733,6 +739,15 @@ struct JSEnv
         MainContext.Reset(Isolate, Context);
 
         CppObjectMapper.Initialize(Isolate, Context);
+        if (BackendEnv.HeapLimitGuard)
+        {
+            // 接近堆上限时先释放等待释放的js对象
+            BackendEnv.HeapLimitGuard->SetCleanupCallback([this]()
+            {
+                v8::HandleScope HandleScope(MainIsolate);
+                CppObjectMapper.ClearPendingPersistentObject(MainIsolate, MainContext.Get(MainIsolate));
+            });
+        }
         Isolate->SetData(MAPPER_ISOLATE_DATA_POS, static_cast<ICppObjectMapper*>(&CppObjectMapper));
         Isolate->SetData(BACKENDENV_DATA_POS, &BackendEnv);
         
@@ -824,6 +839,12 @@ V8_EXPORT puerts::JSEnv* CreateNativeJSEnv()
     return new puerts::JSEnv();
 }
 
+V8_EXPORT puerts::JSEnv* CreateNativeJSEnvWithHeapBudget(int maxOldGenerationSizeMB, int maxYoungGenerationSizeMB)
+{
+    return new puerts::JSEnv(static_cast<size_t>(std::max(maxOldGenerationSizeMB, 0)) * 1024 * 1024,
+        static_cast<size_t>(std::max(maxYoungGenerationSizeMB, 0)) * 1024 * 1024);
+}
+
 V8_EXPORT void DestroyNativeJSEnv(puerts::JSEnv* jsEnv)
 {
     delete jsEnv;
@@ -1147,6 +1168,7 @@ V8_EXPORT void ExchangeAPI(puerts::UnityExports * exports)
     exports->GetJSObjectValue = &puerts::GetJSObjectValue;
     exports->GetModuleExecutor = &puerts::GetModuleExecutor;
     puerts::GUnityExports = *exports;
+    puerts::GExchangedExports = exports;
 }
 
 V8_EXPORT void SetObjectPool(puerts::JSEnv* jsEnv, void* ObjectPoolAddMethodInfo, puerts::ObjectPoolAddFunc ObjectPoolAdd, void* ObjectPoolRemoveMethodInfo, puerts::ObjectPoolRemoveFunc ObjectPoolRemove, void* ObjectPoolInstance)
@@ -1215,6 +1237,55 @@ V8_EXPORT void LogicTick(puerts::JSEnv* jsEnv)
     jsEnv->BackendEnv.LogicTick();
 }
 
+V8_EXPORT int OnFrameIdle(puerts::JSEnv* jsEnv, double idleBudgetInSeconds)
+{
+    return jsEnv->BackendEnv.OnFrameIdle(jsEnv->MainIsolate, idleBudgetInSeconds) ? 1 : 0;
+}
+
+V8_EXPORT const char* GetGCPauseReport(puerts::JSEnv* jsEnv, int* length)
+{
+    static std::string report;
+    report = jsEnv->BackendEnv.GetGCPauseReport();
+    *length = static_cast<int>(report.length());
+    return report.c_str();
+}
+
+V8_EXPORT int StartCpuProfiling(puerts::JSEnv* jsEnv, const char* title, int samplingIntervalUs)
+{
+    return jsEnv->BackendEnv.StartCpuProfiling(jsEnv->MainIsolate, title, samplingIntervalUs) ? 1 : 0;
+}
+
+V8_EXPORT int StopCpuProfiling(puerts::JSEnv* jsEnv, const char* title, const char* outputPath)
+{
+    return jsEnv->BackendEnv.StopCpuProfiling(jsEnv->MainIsolate, title, outputPath) ? 1 : 0;
+}
+
+V8_EXPORT void SetBindingProfilerEnabled(int enabled)
+{
+    puerts::FBindingProfiler::SetEnabled(enabled != 0);
+    // il2cpp侧的MethodCallback通过该函数指针计时，关闭时置空以免额外开销
+    // 生成的包装代码里转换和调用混在一起，只记总耗时，报告中不输出convert_ns
+    puerts::RecordMethodCallFunc record = enabled ? &puerts::FBindingProfiler::RecordWithoutConvert : nullptr;
+    puerts::GUnityExports.RecordMethodCall = record;
+    if (puerts::GExchangedExports)
+    {
+        puerts::GExchangedExports->RecordMethodCall = record;
+    }
+}
+
+V8_EXPORT void ResetBindingProfiler()
+{
+    puerts::FBindingProfiler::Reset();
+}
+
+V8_EXPORT const char* GetBindingProfileReport(int maxEntries, int* length)
+{
+    static std::string report;
+    report = puerts::FBindingProfiler::ToJson(maxEntries > 0 ? static_cast<size_t>(maxEntries) : 0);
+    *length = static_cast<int>(report.length());
+    return report.c_str();
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,47 @@
+﻿#if !EXPERIMENTAL_IL2CPP_PUERTS || !ENABLE_IL2CPP
+using NUnit.Framework;
+using System;
+
+namespace Puerts.UnitTest
+{
+    [TestFixture]
+    public class HeapLimitTest
+    {
+        [Test]
+        public void NearHeapLimitTerminatesAndRecovers()
+        {
+#if PUERTS_GENERAL
+            var jsEnv = new JsEnv(new TxtLoader(), -1, BackendType.V8, 64);
+#else
+            var jsEnv = new JsEnv(new DefaultLoader(), -1, BackendType.V8, 64);
+#endif
+            if (jsEnv.Backend is BackendNodeJS || jsEnv.Backend is BackendQuickJS)
+            {
+                jsEnv.Dispose();
+                return;
+            }
+
+            // 多次触及上限都应终止脚本而不是让进程OOM
+            for (int i = 0; i < 3; i++)
+            {
+                Assert.Catch(() =>
+                {
+                    // 分配放在函数内，终止后不再被脚本作用域引用，可以被回收
+                    jsEnv.Eval(@"
+                        (function () {
+                            const list = [];
+                            while (true) {
+                                list.push(new Array(1024).fill(list.length));
+                            }
+                        })();
+                    ");
+                });
+
+                jsEnv.Tick();
+                Assert.AreEqual(2, jsEnv.Eval<int>("1 + 1"));
+            }
+            jsEnv.Dispose();
+        }
+    }
+}
+#endif
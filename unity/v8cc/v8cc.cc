@@ -3,6 +3,13 @@
 #include <sstream>
 #include <map>
 #include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <filesystem>
+#include <algorithm>
 
 #include "libplatform/libplatform.h"
 #include "v8.h"
@@ -50,165 +57,509 @@ struct CodeCacheHeader {
     uint32_t Checksum;
 };
 
+struct CompileInput {
+    std::string source;   // already wrapped for cjs
+    bool is_module = false;
+    std::string url;
+    int ln = 0;
+    int col = 0;
+};
+
+std::string WrapSource(const std::string& content, bool is_module, bool no_cjs_wrap) {
+    if (!is_module && !no_cjs_wrap) {
+        return "(function (exports, require, module, __filename, __dirname) { " + content + "\n});";
+    }
+    return content;
+}
+
+std::string OutputFilename(const std::string& filename, bool is_module) {
+    auto dot_pos = filename.find_last_of('.');
+    auto slash_pos = filename.find_last_of("/\\");
+    if (dot_pos != std::string::npos && slash_pos != std::string::npos && dot_pos < slash_pos) {
+        dot_pos = std::string::npos;
+    }
+    return filename.substr(0, dot_pos == std::string::npos ? filename.size(): dot_pos) + (is_module ? ".mbc" : ".cbc");
+}
+
+// compile in the given isolate, returns nullptr and fills error on failure
+std::unique_ptr<v8::ScriptCompiler::CachedData> CreateCodeCache(v8::Isolate* isolate, const CompileInput& input,
+    int& source_length, std::string& error) {
+    v8::ScriptCompiler::CachedData* cached_data = nullptr;
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::TryCatch try_catch(isolate);
+    auto script_url = v8::String::NewFromUtf8(isolate, input.url.c_str()).ToLocalChecked();
+    v8::Local<v8::String> source =
+        v8::String::NewFromUtf8(isolate, input.source.c_str()).ToLocalChecked();
+    source_length = source->Length();
+    if (input.is_module) {
+#if V8_MAJOR_VERSION > 8
+        v8::ScriptOrigin origin(isolate, script_url, input.ln, input.col, true, -1, v8::Local<v8::Value>(), false, false, true);
+#else
+        v8::ScriptOrigin origin(script_url, v8::Integer::New(isolate, input.ln), v8::Integer::New(isolate, input.col),
+            v8::True(isolate), v8::Local<v8::Integer>(), v8::Local<v8::Value>(), v8::False(isolate), v8::False(isolate),
+            v8::True(isolate));
+#endif
+        auto module = CompileString<v8::Module>(context, source, origin);
+
+        if (!module.IsEmpty()) {
+            cached_data = v8::ScriptCompiler::CreateCodeCache(module.ToLocalChecked()->GetUnboundModuleScript());
+        }
+    } else {
+#if V8_MAJOR_VERSION > 8
+        v8::ScriptOrigin origin(isolate, script_url, input.ln, input.col);
+#else
+        v8::ScriptOrigin origin(script_url, v8::Integer::New(isolate, input.ln), v8::Integer::New(isolate, input.col));
+#endif
+
+        auto script = CompileString<v8::Script>(context, source, origin);
+        if (!script.IsEmpty()) {
+            cached_data = v8::ScriptCompiler::CreateCodeCache(script.ToLocalChecked()->GetUnboundScript());
+        }
+    }
+    if (try_catch.HasCaught()) {
+        v8::Local<v8::Value> stack_trace;
+        if (try_catch.StackTrace(context).ToLocal(&stack_trace))
+        {
+            v8::String::Utf8Value info(isolate, stack_trace);
+            error = *info;
+        } else {
+            v8::String::Utf8Value info(isolate, try_catch.Exception());
+            error = *info;
+        }
+        delete cached_data;
+        return nullptr;
+    }
+    if (!cached_data) {
+        error = "cached_data is nullptr!!!";
+    }
+    return std::unique_ptr<v8::ScriptCompiler::CachedData>(cached_data);
+}
+
+bool WriteCodeCache(const std::string& output_filename, const v8::ScriptCompiler::CachedData* cached_data) {
+    std::ofstream output_file(output_filename, std::ios::binary);
+    if (!output_file.is_open()) {
+        return false;
+    }
+    output_file.write((const char*)cached_data->data, cached_data->length);
+    return output_file.good();
+}
+
+bool ReadFile(const std::string& filename, std::string& content) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    return true;
+}
+
+// FNV-1a, only used to detect changed inputs between batch runs
+uint64_t HashContent(const std::string& content, bool is_module) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    hash ^= is_module ? 1 : 0;
+    hash *= 1099511628211ULL;
+    return hash;
+}
+
+class V8Runtime {
+public:
+    V8Runtime(const std::string& flags) {
+        v8::V8::SetFlagsFromString(flags.c_str(), flags.size());
+        platform = v8::platform::NewDefaultPlatform();
+        v8::V8::InitializePlatform(platform.get());
+        v8::V8::Initialize();
+    }
+
+    ~V8Runtime() {
+        v8::V8::Dispose();
+#if V8_MAJOR_VERSION > 9
+        v8::V8::DisposePlatform();
+#else
+        v8::V8::ShutdownPlatform();
+#endif
+    }
+
+private:
+    std::unique_ptr<v8::Platform> platform;
+};
+
+class IsolateHolder {
+public:
+    IsolateHolder() {
+        create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        isolate = v8::Isolate::New(create_params);
+    }
+
+    ~IsolateHolder() {
+        isolate->Dispose();
+        delete create_params.array_buffer_allocator;
+    }
+
+    v8::Isolate* isolate;
+
+private:
+    v8::Isolate::CreateParams create_params;
+};
+
+// ---------------- batch mode ----------------
+
+struct BatchEntry {
+    std::string input;
+    std::string path;
+    std::string output;
+    CompileInput compile_input;
+    uint64_t content_hash = 0;
+    bool skipped = false;
+    bool ok = false;
+    uint32_t source_hash = 0;
+    uint32_t bytecode_length = 0;
+    std::string error;
+};
+
+struct IndexRecord {
+    uint64_t content_hash = 0;
+    uint32_t source_hash = 0;
+    uint32_t bytecode_length = 0;
+};
+
+const char* INDEX_HEADER = "# v8cc index v1";
+
+// index format: header line, "version\t<v8 version>", "flags\t<v8 flags>",
+// then one "<input>\t<output>\t<content hash>\t<SourceHash>\t<bytecode length>" per module
+bool LoadIndex(const std::string& index_filename, const std::string& flags, std::map<std::string, IndexRecord>& records) {
+    std::ifstream file(index_filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string line;
+    if (!std::getline(file, line) || line != INDEX_HEADER) {
+        return false;
+    }
+    if (!std::getline(file, line) || line != std::string("version\t") + v8::V8::GetVersion()) {
+        return false;
+    }
+    if (!std::getline(file, line) || line != "flags\t" + flags) {
+        return false;
+    }
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string input, output, content_hash, source_hash, bytecode_length;
+        if (std::getline(fields, input, '\t') && std::getline(fields, output, '\t') && std::getline(fields, content_hash, '\t') &&
+            std::getline(fields, source_hash, '\t') && std::getline(fields, bytecode_length, '\t')) {
+            IndexRecord record;
+            record.content_hash = std::stoull(content_hash, nullptr, 16);
+            record.source_hash = (uint32_t)std::stoul(source_hash);
+            record.bytecode_length = (uint32_t)std::stoul(bytecode_length);
+            records[input] = record;
+        }
+    }
+    return true;
+}
+
+bool SaveIndex(const std::string& index_filename, const std::string& flags, const std::vector<BatchEntry>& entries) {
+    std::ofstream file(index_filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << INDEX_HEADER << "\n";
+    file << "version\t" << v8::V8::GetVersion() << "\n";
+    file << "flags\t" << flags << "\n";
+    for (auto& entry : entries) {
+        if (!entry.ok) {
+            continue;
+        }
+        file << entry.input << "\t" << entry.output << "\t" << std::hex << entry.content_hash << std::dec << "\t"
+             << entry.source_hash << "\t" << entry.bytecode_length << "\n";
+    }
+    return file.good();
+}
+
+// the cache is still usable if the file exists and its header carries the SourceHash recorded in the index
+bool IsCacheUpToDate(const std::string& output_filename, const IndexRecord& record) {
+    std::ifstream file(output_filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open() || (uint32_t)file.tellg() != record.bytecode_length || record.bytecode_length < sizeof(CodeCacheHeader)) {
+        return false;
+    }
+    file.seekg(0);
+    CodeCacheHeader cch;
+    file.read((char*)&cch, sizeof(cch));
+    return file.good() && cch.SourceHash == record.source_hash;
+}
+
+bool IsScriptFile(const std::string& filename) {
+    return endsWith(filename, ".js") || endsWith(filename, ".cjs") || endsWith(filename, ".mjs");
+}
+
+// a directory is scanned recursively for .js/.cjs/.mjs, otherwise the file is a manifest listing one input per line,
+// relative to the manifest's directory; empty lines and lines starting with '#' are ignored
+bool CollectInputs(const std::string& source, std::string& root, std::vector<std::string>& inputs) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (fs::is_directory(source, ec)) {
+        root = source;
+        for (auto it = fs::recursive_directory_iterator(source, ec); !ec && it != fs::recursive_directory_iterator();
+             it.increment(ec)) {
+            if (it->is_regular_file(ec) && IsScriptFile(it->path().string())) {
+                inputs.push_back(fs::relative(it->path(), source, ec).generic_string());
+            }
+        }
+        std::sort(inputs.begin(), inputs.end());
+        return !ec;
+    }
+    std::ifstream manifest(source);
+    if (!manifest.is_open()) {
+        return false;
+    }
+    root = fs::path(source).parent_path().string();
+    std::string line;
+    while (std::getline(manifest, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        inputs.push_back(line);
+    }
+    return true;
+}
+
+int RunBatch(const std::string& source, const std::string& index_option, int jobs, bool force_module, bool no_cjs_wrap,
+    bool verbose, const std::string& flags) {
+    namespace fs = std::filesystem;
+    std::string root;
+    std::vector<std::string> inputs;
+    if (!CollectInputs(source, root, inputs)) {
+        std::cerr << "Error reading batch input: " << source << std::endl;
+        return 1;
+    }
+    std::string index_filename = index_option.empty() ? (fs::path(root) / "v8cc_index.txt").string() : index_option;
+
+    V8Runtime runtime(flags);
+
+    std::map<std::string, IndexRecord> records;
+    bool has_index = LoadIndex(index_filename, flags, records);
+
+    std::vector<BatchEntry> entries(inputs.size());
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        BatchEntry& entry = entries[i];
+        entry.input = inputs[i];
+        bool is_module = force_module || endsWith(entry.input, ".mjs");
+        entry.path = fs::path(entry.input).is_absolute() ? entry.input : (fs::path(root) / entry.input).string();
+        entry.output = OutputFilename(entry.input, is_module);
+        std::string content;
+        if (!ReadFile(entry.path, content)) {
+            entry.error = "Error opening file: " + entry.path;
+            std::cerr << entry.error << std::endl;
+            continue;
+        }
+        entry.compile_input.source = WrapSource(content, is_module, no_cjs_wrap);
+        entry.compile_input.is_module = is_module;
+        entry.compile_input.url = entry.input;
+        entry.content_hash = HashContent(entry.compile_input.source, is_module);
+
+        auto record = records.find(entry.input);
+        if (has_index && record != records.end() && record->second.content_hash == entry.content_hash &&
+            IsCacheUpToDate(OutputFilename(entry.path, is_module), record->second)) {
+            entry.skipped = entry.ok = true;
+            entry.source_hash = record->second.source_hash;
+            entry.bytecode_length = record->second.bytecode_length;
+            continue;
+        }
+        pending.push_back(i);
+    }
+
+    if (jobs <= 0) {
+        jobs = (int)std::thread::hardware_concurrency();
+    }
+    jobs = std::max(1, std::min(jobs, (int)pending.size()));
+
+    // one isolate per worker, inputs are handed out through a shared cursor
+    std::atomic<size_t> cursor(0);
+    std::mutex log_mutex;
+    auto worker = [&]() {
+        IsolateHolder holder;
+        v8::Isolate::Scope isolate_scope(holder.isolate);
+        for (size_t n = cursor++; n < pending.size(); n = cursor++) {
+            BatchEntry& entry = entries[pending[n]];
+            int source_length = 0;
+            auto cached_data = CreateCodeCache(holder.isolate, entry.compile_input, source_length, entry.error);
+            entry.compile_input.source.clear();
+            if (cached_data) {
+                std::string output_filename = OutputFilename(entry.path, entry.compile_input.is_module);
+                if (WriteCodeCache(output_filename, cached_data.get())) {
+                    entry.ok = true;
+                    entry.bytecode_length = (uint32_t)cached_data->length;
+                    entry.source_hash = ((const CodeCacheHeader*)cached_data->data)->SourceHash;
+                } else {
+                    entry.error = "Error creating file: " + output_filename;
+                }
+            }
+            std::lock_guard<std::mutex> guard(log_mutex);
+            if (!entry.ok) {
+                std::cerr << entry.input << ": " << entry.error << std::endl;
+            } else if (verbose) {
+                std::cout << "compiled: " << entry.input << ", source length: " << source_length
+                          << ", bytecode length: " << entry.bytecode_length << std::endl;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < jobs; ++i) {
+        threads.emplace_back(worker);
+    }
+    if (!pending.empty()) {
+        worker();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    int compiled = 0;
+    int skipped = 0;
+    int failed = 0;
+    for (auto& entry : entries) {
+        if (entry.skipped) {
+            ++skipped;
+        } else if (entry.ok) {
+            ++compiled;
+        } else {
+            ++failed;
+        }
+    }
+
+    if (!SaveIndex(index_filename, flags, entries)) {
+        std::cerr << "Error creating file: " << index_filename << std::endl;
+        return 1;
+    }
+    std::cout << "v8cc batch: " << compiled << " compiled, " << skipped << " unchanged, " << failed << " failed, "
+              << jobs << " isolate(s), index: " << index_filename << std::endl;
+    return failed > 0 ? 1 : 0;
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         std::cerr << "Usage: " << argv[0] << " <filename> [--module] [--no-cjs-wrap] [--verbose] [--url=<string>] [--ln=<number>] [--col=<number>] [v8_flag1] [v8_flag2] ..." << std::endl;
+        std::cerr << "       " << argv[0] << " --batch=<directory|manifest> [--jobs=<number>] [--index=<file>] [--module] [--no-cjs-wrap] [--verbose] [v8_flag1] ..." << std::endl;
         return 1;
     }
 
     std::string filename = argv[1];
+    std::string batch_source;
+    std::string index_filename;
+    int jobs = 0;
     bool is_module = endsWith(filename, ".mjs");
+    bool force_module = false;
     bool no_cjs_wrap = false;
     bool verbose = false;
     std::string flags = "--no-lazy --no-flush-bytecode --no-enable-lazy-source-positions";
     std::string url = filename;
     int ln = 0;
     int col = 0;
-    if (argc > 2) {
-        for (int i = 2; i < argc; ++i) {
-            std::string arg = argv[i];
-            if (arg == "--module") {
-                is_module = true;
-                continue;
-            }
-            if (arg == "--no-cjs-wrap") {
-                no_cjs_wrap = true;
-                continue;
-            }
-            if (arg == "--verbose") {
-                verbose = true;
-                continue;
-            }
-            if (arg.rfind("--url=", 0) == 0) {
-                url = arg.substr(6);
-                continue;
-            }
-            if (arg.rfind("--ln=", 0) == 0) {
-                ln = std::stoi(arg.substr(5));
-                continue;
-            }
-            if (arg.rfind("--col=", 0) == 0) {
-                col = std::stoi(arg.substr(6));
-                continue;
-            }
-            flags += (" " + arg);
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i == 1 && arg.rfind("--batch=", 0) != 0) {
+            continue;
+        }
+        if (arg.rfind("--batch=", 0) == 0) {
+            batch_source = arg.substr(8);
+            continue;
+        }
+        if (arg.rfind("--jobs=", 0) == 0) {
+            jobs = std::stoi(arg.substr(7));
+            continue;
+        }
+        if (arg.rfind("--index=", 0) == 0) {
+            index_filename = arg.substr(8);
+            continue;
+        }
+        if (arg == "--module") {
+            is_module = true;
+            force_module = true;
+            continue;
         }
+        if (arg == "--no-cjs-wrap") {
+            no_cjs_wrap = true;
+            continue;
+        }
+        if (arg == "--verbose") {
+            verbose = true;
+            continue;
+        }
+        if (arg.rfind("--url=", 0) == 0) {
+            url = arg.substr(6);
+            continue;
+        }
+        if (arg.rfind("--ln=", 0) == 0) {
+            ln = std::stoi(arg.substr(5));
+            continue;
+        }
+        if (arg.rfind("--col=", 0) == 0) {
+            col = std::stoi(arg.substr(6));
+            continue;
+        }
+        flags += (" " + arg);
     }
-    
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+
+    if (!batch_source.empty()) {
+        return RunBatch(batch_source, index_filename, jobs, force_module, no_cjs_wrap, verbose, flags);
+    }
+
+    std::string fileContent;
+    if (!ReadFile(filename, fileContent)) {
         std::cerr << "Error opening file: " << filename << std::endl;
         return 1;
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
+    CompileInput input;
+    input.source = WrapSource(fileContent, is_module, no_cjs_wrap);
+    input.is_module = is_module;
+    input.url = url;
+    input.ln = ln;
+    input.col = col;
 
-    std::string fileContent = buffer.str();
-    
-    v8::V8::SetFlagsFromString(flags.c_str(), flags.size());
-    
-    file.close();
-    
-    v8::ScriptCompiler::CachedData* cached_data = nullptr;
-    // --- begin get code cache ---
-    std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
-    v8::V8::InitializePlatform(platform.get());
-    v8::V8::Initialize();
-
-    // Create a new Isolate and make it the current one.
-    v8::Isolate::CreateParams create_params;
-    create_params.array_buffer_allocator =
-        v8::ArrayBuffer::Allocator::NewDefaultAllocator();
-    v8::Isolate* isolate = v8::Isolate::New(create_params);
+    std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data;
     int source_length = 0;
+    std::string error;
     {
-        v8::Isolate::Scope isolate_scope(isolate);
-        v8::HandleScope handle_scope(isolate);
-        v8::Local<v8::Context> context = v8::Context::New(isolate);
-        v8::Context::Scope context_scope(context);
-        v8::TryCatch try_catch(isolate);
-        auto script_url = v8::String::NewFromUtf8(isolate, url.c_str()).ToLocalChecked();
-        if (!is_module && !no_cjs_wrap) {
-            fileContent = "(function (exports, require, module, __filename, __dirname) { " + fileContent + "\n});";
-        }
-        v8::Local<v8::String> source =
-            v8::String::NewFromUtf8(isolate, fileContent.c_str()).ToLocalChecked();
-        source_length = source->Length();
-        if (is_module) {
-#if V8_MAJOR_VERSION > 8
-            v8::ScriptOrigin origin(isolate, script_url, ln, col, true, -1, v8::Local<v8::Value>(), false, false, true);
-#else
-            v8::ScriptOrigin origin(script_url, v8::Integer::New(isolate, ln), v8::Integer::New(isolate, col), v8::True(isolate),
-                v8::Local<v8::Integer>(), v8::Local<v8::Value>(), v8::False(isolate), v8::False(isolate), v8::True(isolate));
-#endif
-            auto module = CompileString<v8::Module>(context, source, origin);
-            
-            if (!module.IsEmpty()) {
-                cached_data = v8::ScriptCompiler::CreateCodeCache(module.ToLocalChecked()->GetUnboundModuleScript());
-            }
-        } else {
-#if V8_MAJOR_VERSION > 8
-            v8::ScriptOrigin origin(isolate, script_url, ln, col);
-#else
-            v8::ScriptOrigin origin(script_url, v8::Integer::New(isolate, ln), v8::Integer::New(isolate, col));
-#endif
-            
-            auto script = CompileString<v8::Script>(context, source, origin);
-            if (!script.IsEmpty()) {
-                cached_data = v8::ScriptCompiler::CreateCodeCache(script.ToLocalChecked()->GetUnboundScript());
-            }
-        }
-        if (try_catch.HasCaught()) {
-            v8::Local<v8::Value> stack_trace;
-            if (try_catch.StackTrace(context).ToLocal(&stack_trace))
-            {
-                v8::String::Utf8Value info(isolate, stack_trace);
-                std::cout << (*info) << std::endl;
-            }
-            return 1;
-        }
+        V8Runtime runtime(flags);
+        IsolateHolder holder;
+        v8::Isolate::Scope isolate_scope(holder.isolate);
+        cached_data = CreateCodeCache(holder.isolate, input, source_length, error);
     }
 
-    // Dispose the isolate and tear down V8.
-    isolate->Dispose();
-    v8::V8::Dispose();
-#if V8_MAJOR_VERSION > 9
-    v8::V8::DisposePlatform();
-#else
-    v8::V8::ShutdownPlatform();
-#endif
-    delete create_params.array_buffer_allocator;
-    // --- end get code cache ---
-    
     if (!cached_data) {
-        std::cout << "cached_data is nullptr!!!" << std::endl;
+        std::cout << error << std::endl;
+        return 1;
     }
-    
-    auto dot_pos = filename.find_last_of('.');
-    std::string output_filename = filename.substr(0, dot_pos == std::string::npos ? filename.size(): dot_pos) + (is_module ? ".mbc" : ".cbc");
-    
-    std::ofstream output_file(output_filename, std::ios::binary);
-    if (!output_file.is_open()) {
+
+    std::string output_filename = OutputFilename(filename, is_module);
+    if (!WriteCodeCache(output_filename, cached_data.get())) {
         std::cerr << "Error creating file: " << output_filename << std::endl;
         return 1;
     }
-    
-    output_file.write((const char*)cached_data->data, cached_data->length);
-    output_file.close();
-    
+
     if (verbose) {
         std::cout << "esm: " << is_module << std::endl;
         std::cout << "cjs: " << (!is_module && !no_cjs_wrap) << std::endl;
         std::cout << "v8 flags: " << flags << std::endl;
-        
+
         //std::cout << fileContent << std::endl;
         std::cout << "input : " << filename << ", source length: " << source_length << std::endl;
         std::cout << "output: " << output_filename << ", bytecode length: " << cached_data->length << std::endl;
         std::cout << "url: " << url << std::endl;
         std::cout << "line offset: " << ln << std::endl;
         std::cout << "column offset: " << col << std::endl;
-        
+
         const CodeCacheHeader *cch = (const CodeCacheHeader *)cached_data->data;
         std::cout << "MagicNumber : " << cch->MagicNumber << std::endl;
         std::cout << "VersionHash : " << cch->VersionHash << std::endl;
@@ -217,8 +568,6 @@ int main(int argc, char* argv[]) {
         std::cout << "PayloadLength : " << cch->PayloadLength << std::endl;
         std::cout << "Checksum : " << cch->Checksum << std::endl;
     }
-    
-    delete cached_data;
-    
+
     return 0;
 }
\ No newline at end of file
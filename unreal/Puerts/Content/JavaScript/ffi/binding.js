@@ -9,6 +9,7 @@ const ffi_bindings = require('ffi_bindings');
 const typeInfo = require('type').typeInfo;
 const pointer = typeInfo('pointer');
 const ffi_call = ffi_bindings.ffi_call;
+const ffi_call_fast = ffi_bindings.ffi_call_fast;
 const UTF8Length = ffi_bindings.UTF8Length;
 const writeUTF8String = ffi_bindings.writeUTF8String;
 const readUTF8String = ffi_bindings.readUTF8String;
@@ -28,6 +29,12 @@ function id(x) {
 function allocCif(returnType, parameterTypes, abi, fixArgNum) {
     let param_ffi_types = parameterTypes.map(t => t.ffi_type);
     
+    // signatures made of primitive types share one native cif
+    const cachedCif = ffi_bindings.ffi_prep_cif_cached(abi, typeof fixArgNum === 'number' ? fixArgNum : -1, returnType.ffi_type, pointer.alloc(...param_ffi_types), parameterTypes.length);
+    if (cachedCif) {
+        return cachedCif;
+    }
+    
     let cifPtr = new Uint8Array(ffi_bindings.FFI_CIF_SIZE);
     let status
     if (typeof fixArgNum === 'number') {
@@ -41,6 +48,24 @@ function allocCif(returnType, parameterTypes, abi, fixArgNum) {
     return cifPtr;
 }
 
+const fastSignatureCodes = {
+    'void': 'v', 'int32': 'i', 'uint32': 'I',
+    'int64': 'l', 'uint64': 'L', 'pointer': 'p', 'cstring': 'p', 'double': 'd',
+    'size_t': ffi_bindings.POINTER_SIZE == 4 ? 'I' : 'L'
+};
+
+function fastThunk(abi, returnType, parameterTypes, fixArgNum) {
+    if (abi !== ffi_bindings.FFI_DEFAULT_ABI || typeof fixArgNum === 'number') return undefined;
+    let signature = fastSignatureCodes[returnType];
+    if (typeof returnType !== 'string' || !signature) return undefined;
+    for (var i = 0; i < parameterTypes.length; i++) {
+        const code = fastSignatureCodes[parameterTypes[i]];
+        if (typeof parameterTypes[i] !== 'string' || !code || code === 'v') return undefined;
+        signature += code;
+    }
+    return ffi_bindings.ffi_get_fast_thunk(signature) || undefined;
+}
+
 function binding(func, abi, returnType, parameterTypes, fixArgNum) {
     if (typeof abi !== 'number') {
         fixArgNum = parameterTypes;
@@ -51,6 +76,21 @@ function binding(func, abi, returnType, parameterTypes, fixArgNum) {
 
     const argsProcessers = parameterTypes.map(t => t === 'cstring' ? stringToCString : id);
     const resultProcesser = returnType === 'cstring' ? readUTF8String : id;
+    
+    // common signatures call through a pre-instantiated native thunk, skipping ffi_call and the argument buffers
+    const thunk = fastThunk(abi, returnType, parameterTypes, fixArgNum);
+    if (thunk) {
+        const expectFastArgNum = parameterTypes.length;
+        return function wrap(...args) {
+            if (args.length != expectFastArgNum) {
+                throw new Error(`expect ${expectFastArgNum} argument but got ${args.length}`);
+            }
+            for (var i = 0; i < expectFastArgNum; i++) {
+                args[i] = argsProcessers[i](args[i]);
+            }
+            return resultProcesser(ffi_call_fast(thunk, func, ...args));
+        };
+    }
     returnType = typeInfo(returnType);
     parameterTypes = parameterTypes.map(t => typeInfo(t));
     const cifPtr = allocCif(returnType, parameterTypes, abi, fixArgNum);
@@ -95,5 +95,31 @@ var global = global || (function () { return this; }());
         }
     };
     
+    // affected: the changed module and all of its transitive importers, roots: affected modules nobody imports.
+    // Re-require from the roots; unaffected modules hit the module cache and are not evaluated again.
+    // Returns false if any root failed, so the caller can restore the import edges it dropped.
+    function reloadGraph(url, affected, roots) {
+        let succeeded = true;
+        let m = puerts.getModuleByUrl(url);
+        puerts.emit('HMR.prepare', undefined, m, url);
+        for (const key of affected) {
+            if (puerts.getModuleByUrl(key)) {
+                puerts.forceReload(key);
+            }
+        }
+        for (const key of roots) {
+            try {
+                puerts.__require(key);
+            } catch (e) {
+                succeeded = false;
+                console.error(`reload ${key} fail: ${e.stack || e}`);
+            }
+        }
+        puerts.emit('HMR.finish', undefined, puerts.getModuleByUrl(url), url);
+        return succeeded;
+    }
+    
     puerts.__reload = reload;
+    
+    puerts.__reloadGraph = reloadGraph;
 }(global));
@@ -35,6 +35,9 @@ var global = global || (function () { return this; }());
     let findModule = global.__tgjsFindModule;
     global.__tgjsFindModule = undefined;
     
+    let addModuleImport = global.__tgjsAddModuleImport;
+    global.__tgjsAddModuleImport = undefined;
+    
     let tmpModuleStorage = [];
     
     function addModule(m) {
@@ -53,21 +56,21 @@ var global = global || (function () { return this; }());
 
     let moduleCache = Object.create(null);
     let buildinModule = Object.create(null);
-    function executeModule(fullPath, script, debugPath, sid, isESM, bytecode) {
+    function executeModule(fullPath, script, debugPath, sid, isESM, bytecode, wrapped) {
         sid = (typeof sid == 'undefined') ? 0 : sid;
         let fullPathInJs = fullPath.replace(/\\/g, '\\\\');
         let fullDirInJs = (fullPath.indexOf('/') != -1) ? fullPath.substring(0, fullPath.lastIndexOf("/")) : fullPath.substring(0, fullPath.lastIndexOf("\\")).replace(/\\/g, '\\\\');
         let exports = {};
         let module = puerts.getModuleBySID(sid);
         module.exports = exports;
-        let wrapped = evalScript(
+        let compiled = evalScript(
             // Wrap the script in the same way NodeJS does it. It is important since IDEs (VSCode) will use this wrapper pattern
             // to enable stepping through original source in-place.
-            (isESM || bytecode) ? script: "(function (exports, require, module, __filename, __dirname) { " + script + "\n});", 
+            (isESM || bytecode || wrapped) ? script: "(function (exports, require, module, __filename, __dirname) { " + script + "\n});", 
             debugPath, isESM, fullPath, bytecode
         )
-        if (isESM) return wrapped;
-        wrapped(exports, puerts.genRequire(fullDirInJs), module, fullPathInJs, fullDirInJs)
+        if (isESM) return compiled;
+        compiled(exports, puerts.genRequire(fullDirInJs, undefined, fullPath), module, fullPathInJs, fullDirInJs)
         return module.exports;
     }
     
@@ -76,18 +79,6 @@ var global = global || (function () { return this; }());
         return (packageConfigure && packageConfigure.type === "module") ? packageConfigure.main : undefined;
     }
     
-    function getSourceLengthFromBytecode(buf, isESM) {
-        let sourceHash = (new Uint32Array(buf))[2];
-        //console.log(`sourceHash:${sourceHash}`);
-        const kModuleFlagMask = (1 << 31);
-        const mask = isESM ? kModuleFlagMask : 0;
-
-        // Remove the mask to get the original length
-        const length = sourceHash & ~mask;
-
-        return length;
-    }
-    
     let baseString
     function generateEmptyCode(length) {
         if (baseString === undefined) {
@@ -102,7 +93,7 @@ var global = global || (function () { return this; }());
         }
     }
     
-    function genRequire(requiringDir, outerIsESM) {
+    function genRequire(requiringDir, outerIsESM, requiringPath) {
         let localModuleCache = Object.create(null);
         function require(moduleName) {
             if (org_require) {
@@ -137,7 +128,10 @@ var global = global || (function () { return this; }());
             }
             
             let key = fullPath;
-            if ((key in moduleCache) && !forceReload) {
+            if (addModuleImport) {
+                addModuleImport(requiringPath || "", key);
+            }
+            if ((key in moduleCache) && !forceReload && moduleCache[key] && !moduleCache[key].__forceReload) {
                 localModuleCache[moduleName] = moduleCache[key];
                 return localModuleCache[moduleName].exports;
             }
@@ -147,11 +141,15 @@ var global = global || (function () { return this; }());
             let sid = addModule(m);
             let isESM = outerIsESM === true || fullPath.endsWith(".mjs") || fullPath.endsWith(".mbc");
             if (fullPath.endsWith(".cjs") || fullPath.endsWith(".cbc")) isESM = false;
-            let script = isESM ? undefined : loadModule(fullPath);
+            let isBytecode = fullPath.endsWith(".mbc") || fullPath.endsWith(".cbc");
+            // commonjs sources are wrapped natively so the wrapper does not copy the whole source on the js heap
+            let wrapped = !isESM && !isBytecode && !fullPath.endsWith(".json");
+            let script = isESM ? undefined : loadModule(fullPath, wrapped);
             let bytecode = undefined;
-            if (fullPath.endsWith(".mbc") || fullPath.endsWith(".cbc")) {
+            if (isBytecode) {
+                // placeholder source is generated natively from the bytecode header
                 bytecode = script;
-                script = generateEmptyCode(getSourceLengthFromBytecode(bytecode));
+                script = undefined;
             }
             try {
                 if (fullPath.endsWith(".json")) {
@@ -172,7 +170,7 @@ var global = global || (function () { return this; }());
                             }
                         }
                         let fullDirInJs = (fullPath.indexOf('/') != -1) ? fullPath.substring(0, fullPath.lastIndexOf("/")) : fullPath.substring(0, fullPath.lastIndexOf("\\")).replace(/\\/g, '\\\\');
-                        let tmpRequire = genRequire(fullDirInJs, isESM);
+                        let tmpRequire = genRequire(fullDirInJs, isESM, fullPath);
                         let r = tmpRequire(url);
                         
                         m.exports = r;
@@ -180,7 +178,7 @@ var global = global || (function () { return this; }());
                         m.exports = packageConfigure;
                     }
                 } else {
-                    let r = executeModule(fullPath, script, debugPath, sid, isESM, bytecode);
+                    let r = executeModule(fullPath, script, debugPath, sid, isESM, bytecode, wrapped);
                     if (isESM) {
                         m.exports = r;
                     }
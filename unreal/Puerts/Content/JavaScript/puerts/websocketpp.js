@@ -53,10 +53,11 @@ var global = global || (function () { return this; }());
     const poll_ws_objects = [];
     
     class WebSocket extends EventTarget {
-        constructor(url, protocols) {
+        // options.backgroundThread: run network I/O on a native thread, events are delivered in batches on poll
+        constructor(url, protocols, options) {
             super();
             if (protocols) throw new Error('do not support protocols argument');
-            this._raw = new WebSocketPP(url);
+            this._raw = new WebSocketPP(url, !!(options && options.backgroundThread));
             this._url = url;
             // !!do not raise exception in handles.
             this._raw.setHandles(
@@ -109,8 +110,11 @@ var global = global || (function () { return this; }());
             if (this._pendingEvents.length === 0 && this._readyState != WebSocket.CLOSING) {
                 this._raw.poll();
             } 
-            const ev = this._pendingEvents.shift();
-            if (ev) this.dispatchEvent(ev);
+            const events = this._pendingEvents;
+            this._pendingEvents = [];
+            for (let i = 0; i < events.length; i++) {
+                this.dispatchEvent(events[i]);
+            }
             if (this._pendingEvents.length === 0 && this._readyState == WebSocket.CLOSING) {
                 this._raw = undefined;
                 clearInterval(this._tid);
@@ -43,6 +43,9 @@
 #include "FileSystemOperation.h"
 #endif
 #include "PathEscape.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 #define STRINGIZE(x) #x
 #define STRINGIZE_VALUE_OF(x) STRINGIZE(x)
@@ -345,9 +348,14 @@ void FTypeScriptDeclarationGenerator::InitExtensionMethodsMap()
 
 void FTypeScriptDeclarationGenerator::GenTypeScriptDeclaration(bool InGenStruct, bool InGenEnum)
 {
+    const double StartTime = FPlatformTime::Seconds();
     Begin();
     BeginGenAssetData = false;
     TArray<UObject*> SortedClasses(GetSortedClasses(InGenStruct, InGenEnum));
+    if (PrepareInParallel)
+    {
+        PrepareTypeDeclarations(SortedClasses, UseDeclarationCache);
+    }
     for (int i = 0; i < SortedClasses.Num(); ++i)
     {
         UObject* Class = SortedClasses[i];
@@ -399,6 +407,9 @@ void FTypeScriptDeclarationGenerator::GenTypeScriptDeclaration(bool InGenStruct,
     }
     BeginGenAssetData = false;
     End();
+    PreparedDecls.Empty();
+    UE_LOG(LogTemp, Display, TEXT("ue.d.ts generated in %.3fs (%s)"), FPlatformTime::Seconds() - StartTime,
+        PrepareInParallel ? (UseDeclarationCache ? TEXT("incremental") : TEXT("full")) : TEXT("serial"));
 
     IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
     PlatformFile.CopyDirectoryTree(*(FPaths::ProjectDir() / TEXT("Typing")),
@@ -510,6 +521,11 @@ void FTypeScriptDeclarationGenerator::NamespaceEnd(UObject* Obj, FStringBuffer&
 
 void FTypeScriptDeclarationGenerator::WriteOutput(UObject* Obj, const FStringBuffer& Buff)
 {
+    if (RecordOnly)
+    {
+        RecordedDecl = Buff.Buffer;
+        return;
+    }
     const UPackage* Pkg = GetPackage(Obj);
     bool IsPluginBPClass = Pkg && !Obj->IsNative() && !Pkg->GetName().StartsWith(TEXT("/Game/"));
     if (Pkg && !Obj->IsNative() && !IsPluginBPClass && BlueprintTypeDeclInfoCache.Find(Pkg->GetFName()))
@@ -648,6 +664,11 @@ void FTypeScriptDeclarationGenerator::LoadAllWidgetBlueprint(FName InSearchPath,
 
 void FTypeScriptDeclarationGenerator::Gen(UObject* ToGen)
 {
+    if (RecordOnly)
+    {
+        RecordedDependencies.Add(ToGen);
+        return;
+    }
     if (ToGen->GetName().Equals(TEXT("ArrayBuffer")) || ToGen->GetName().Equals(TEXT("ArrayBufferValue")) ||
         ToGen->GetName().Equals(TEXT("JsObject")))
     {
@@ -681,6 +702,23 @@ void FTypeScriptDeclarationGenerator::Gen(UObject* ToGen)
         }
     }
 
+    if (const FPreparedTypeDecl* Prepared = PreparedDecls.Find(ToGen))
+    {
+        for (UObject* Dependency : Prepared->Dependencies)
+        {
+            Gen(Dependency);
+        }
+        if (auto Struct = Cast<UStruct>(ToGen))
+        {
+            AllFuncionOutputs[Struct] = Prepared->Functions;
+        }
+        if (!Prepared->Decl.IsEmpty())
+        {
+            WriteOutput(ToGen, FStringBuffer{Prepared->Decl, ""});
+        }
+        return;
+    }
+
     if (auto Class = Cast<UClass>(ToGen))
     {
         GenClass(Class);
@@ -1474,6 +1512,568 @@ void FTypeScriptDeclarationGenerator::GenStruct(UStruct* Struct)
     WriteOutput(Struct, StringBuffer);
 }
 
+// 增量缓存的格式版本,生成逻辑有改动时需要加一
+static const int32 DeclarationCacheVersion = 1;
+
+struct FCachedFunctionOverloads
+{
+    FString Name;
+    bool IsStatic = false;
+    TArray<FString> Overloads;
+
+    friend FArchive& operator<<(FArchive& Ar, FCachedFunctionOverloads& Item)
+    {
+        Ar << Item.Name << Item.IsStatic << Item.Overloads;
+        return Ar;
+    }
+};
+
+struct FCachedTypeDecl
+{
+    FSHAHash Signature;
+    FString Decl;
+    TArray<FString> Dependencies;
+    TArray<FCachedFunctionOverloads> Functions;
+
+    friend FArchive& operator<<(FArchive& Ar, FCachedTypeDecl& Item)
+    {
+        Ar << Item.Signature << Item.Decl << Item.Dependencies << Item.Functions;
+        return Ar;
+    }
+};
+
+struct FDeclarationHasher
+{
+    FSHA1 Sha;
+
+    void Add(uint64 Value)
+    {
+        Sha.Update(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+    }
+
+    void Add(const FString& Str)
+    {
+        Add((uint64) Str.Len());
+        Sha.Update(reinterpret_cast<const uint8*>(*Str), Str.Len() * sizeof(TCHAR));
+    }
+
+    void Add(const FSHAHash& Hash)
+    {
+        Sha.Update(Hash.Hash, sizeof(Hash.Hash));
+    }
+
+    void Add(const UObject* Obj)
+    {
+        Add(Obj ? Obj->GetPathName() : FString());
+    }
+
+    FSHAHash Finish()
+    {
+        FSHAHash Result;
+        Sha.Final();
+        Sha.GetHash(Result.Hash);
+        return Result;
+    }
+};
+
+static FString GetDeclarationCachePath()
+{
+    return FPaths::ProjectIntermediateDir() / TEXT("Puerts/DeclarationCache.bin");
+}
+
+// 影响所有类型输出的全局因素,变化时整个缓存失效
+static FSHAHash GetDeclarationCacheSalt()
+{
+    FDeclarationHasher Hasher;
+    Hasher.Add((uint64) DeclarationCacheVersion);
+    Hasher.Add((uint64) ENGINE_MAJOR_VERSION);
+    Hasher.Add((uint64) ENGINE_MINOR_VERSION);
+#ifdef PUERTS_WITH_EDITOR_SUFFIX
+    Hasher.Add(FString(TEXT("PUERTS_WITH_EDITOR_SUFFIX")));
+#endif
+#ifdef PUERTS_FTEXT_AS_OBJECT
+    Hasher.Add(FString(TEXT("PUERTS_FTEXT_AS_OBJECT")));
+#endif
+#if defined(WITHOUT_BP_NAMESPACE)
+    Hasher.Add(FString(TEXT("WITHOUT_BP_NAMESPACE")));
+#endif
+    for (const FString& Name : IPuertsModule::Get().GetIgnoreClassListOnDTS())
+    {
+        Hasher.Add(Name);
+    }
+    Hasher.Add(FString(TEXT("|")));
+    for (const FString& Name : IPuertsModule::Get().GetIgnoreStructListOnDTS())
+    {
+        Hasher.Add(Name);
+    }
+    return Hasher.Finish();
+}
+
+static bool LoadDeclarationCache(TMap<FString, FCachedTypeDecl>& OutCache)
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *GetDeclarationCachePath(), FILEREAD_Silent))
+    {
+        return false;
+    }
+    FMemoryReader Reader(Data);
+    int32 Version = 0;
+    FSHAHash Salt;
+    Reader << Version << Salt;
+    if (Reader.IsError() || Version != DeclarationCacheVersion || !(Salt == GetDeclarationCacheSalt()))
+    {
+        return false;
+    }
+    Reader << OutCache;
+    if (Reader.IsError())
+    {
+        OutCache.Empty();
+        return false;
+    }
+    return true;
+}
+
+static void SaveDeclarationCache(TMap<FString, FCachedTypeDecl>& Cache)
+{
+    TArray<uint8> Data;
+    FMemoryWriter Writer(Data);
+    int32 Version = DeclarationCacheVersion;
+    FSHAHash Salt = GetDeclarationCacheSalt();
+    Writer << Version << Salt << Cache;
+    FFileHelper::SaveArrayToFile(Data, *GetDeclarationCachePath());
+}
+
+static void HashFunction(FDeclarationHasher& Hasher, UFunction* Function);
+
+static void HashProperty(FDeclarationHasher& Hasher, PropertyMacro* Property)
+{
+    if (!Property)
+    {
+        Hasher.Add(FString());
+        return;
+    }
+    Hasher.Add(Property->GetName());
+    Hasher.Add(Property->GetClass()->GetName());
+    Hasher.Add((uint64) Property->PropertyFlags);
+    Hasher.Add((uint64) Property->ArrayDim);
+
+    if (auto EnumProperty = CastFieldMacro<EnumPropertyMacro>(Property))
+    {
+        Hasher.Add(EnumProperty->GetEnum());
+    }
+    else if (auto ByteProperty = CastFieldMacro<BytePropertyMacro>(Property))
+    {
+        Hasher.Add(ByteProperty->GetIntPropertyEnum());
+    }
+    else if (auto StructProperty = CastFieldMacro<StructPropertyMacro>(Property))
+    {
+        Hasher.Add(StructProperty->Struct);
+    }
+    else if (auto ArrayProperty = CastFieldMacro<ArrayPropertyMacro>(Property))
+    {
+        HashProperty(Hasher, ArrayProperty->Inner);
+    }
+    else if (auto SetProperty = CastFieldMacro<SetPropertyMacro>(Property))
+    {
+        HashProperty(Hasher, SetProperty->ElementProp);
+    }
+    else if (auto MapProperty = CastFieldMacro<MapPropertyMacro>(Property))
+    {
+        HashProperty(Hasher, MapProperty->KeyProp);
+        HashProperty(Hasher, MapProperty->ValueProp);
+    }
+    else if (auto SoftClassProperty = CastFieldMacro<SoftClassPropertyMacro>(Property))
+    {
+        Hasher.Add(SoftClassProperty->PropertyClass);
+        Hasher.Add(SoftClassProperty->MetaClass);
+    }
+    else if (auto ObjectProperty = CastFieldMacro<ObjectPropertyBaseMacro>(Property))
+    {
+        Hasher.Add(ObjectProperty->PropertyClass);
+    }
+    else if (auto InterfaceProperty = CastFieldMacro<InterfacePropertyMacro>(Property))
+    {
+        Hasher.Add(InterfaceProperty->InterfaceClass);
+    }
+    else if (auto DelegateProperty = CastFieldMacro<DelegatePropertyMacro>(Property))
+    {
+        HashFunction(Hasher, DelegateProperty->SignatureFunction);
+    }
+    else if (auto MulticastDelegateProperty = CastFieldMacro<MulticastDelegatePropertyMacro>(Property))
+    {
+        HashFunction(Hasher, MulticastDelegateProperty->SignatureFunction);
+    }
+}
+
+static void HashFunction(FDeclarationHasher& Hasher, UFunction* Function)
+{
+    if (!Function)
+    {
+        Hasher.Add(FString());
+        return;
+    }
+    Hasher.Add(Function->GetName());
+    Hasher.Add((uint64) Function->FunctionFlags);
+    for (TFieldIterator<PropertyMacro> ParamIt(Function); ParamIt; ++ParamIt)
+    {
+        HashProperty(Hasher, *ParamIt);
+    }
+    // 参数默认值(CPP_Default_)和ToolTip都会进到声明里
+    if (TMap<FName, FString>* MetaMap = UMetaData::GetMapForObject(Function))
+    {
+        TArray<FName> Keys;
+        MetaMap->GetKeys(Keys);
+        Keys.Sort(FNameLexicalLess());
+        for (const FName& Key : Keys)
+        {
+            Hasher.Add(Key.ToString());
+            Hasher.Add((*MetaMap)[Key]);
+        }
+    }
+}
+
+// 类型自身的反射签名,不含父类,父类的签名在PrepareTypeDeclarations里按继承链合并
+static FSHAHash HashTypeSignature(UObject* Type, const std::vector<UFunction*>* ExtensionMethods)
+{
+    FDeclarationHasher Hasher;
+    Hasher.Add(Type);
+    Hasher.Add(Type->GetClass());
+
+    if (auto Enum = Cast<UEnum>(Type))
+    {
+        Hasher.Add((uint64) Enum->NumEnums());
+        for (int i = 0; i < Enum->NumEnums(); ++i)
+        {
+            Hasher.Add(Enum->GetNameStringByIndex(i));
+        }
+        return Hasher.Finish();
+    }
+
+    auto Struct = Cast<UStruct>(Type);
+    if (!Struct)
+    {
+        return Hasher.Finish();
+    }
+
+    Hasher.Add(Struct->GetSuperStruct());
+    for (TFieldIterator<PropertyMacro> PropertyIt(Struct, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
+    {
+        HashProperty(Hasher, *PropertyIt);
+    }
+
+    if (auto Class = Cast<UClass>(Struct))
+    {
+        for (TFieldIterator<UFunction> FunctionIt(Class, EFieldIteratorFlags::ExcludeSuper); FunctionIt; ++FunctionIt)
+        {
+            HashFunction(Hasher, *FunctionIt);
+        }
+        for (int i = 0; i < Class->Interfaces.Num(); i++)
+        {
+            Hasher.Add(Class->Interfaces[i].Class);
+            for (TFieldIterator<UFunction> FunctionIt(Class->Interfaces[i].Class, EFieldIteratorFlags::IncludeSuper); FunctionIt;
+                 ++FunctionIt)
+            {
+                HashFunction(Hasher, *FunctionIt);
+            }
+        }
+    }
+
+    if (ExtensionMethods)
+    {
+        for (UFunction* Function : *ExtensionMethods)
+        {
+            Hasher.Add(Function);
+            HashFunction(Hasher, Function);
+        }
+    }
+
+    auto ClassDefinition = PUERTS_NAMESPACE::FindClassByType(Struct);
+    if (ClassDefinition)
+    {
+        for (auto FunctionInfo = ClassDefinition->FunctionInfos; FunctionInfo && FunctionInfo->Name && FunctionInfo->Type;
+             ++FunctionInfo)
+        {
+            FStringBuffer Tmp;
+            GenTemplateBindingFunction(Tmp, FunctionInfo, true);
+            Hasher.Add(Tmp.Buffer);
+        }
+        for (auto MethodInfo = ClassDefinition->MethodInfos; MethodInfo && MethodInfo->Name && MethodInfo->Type; ++MethodInfo)
+        {
+            FStringBuffer Tmp;
+            GenTemplateBindingFunction(Tmp, MethodInfo, false);
+            Hasher.Add(Tmp.Buffer);
+        }
+        for (auto PropertyInfo = ClassDefinition->PropertyInfos; PropertyInfo && PropertyInfo->Name && PropertyInfo->Type;
+             ++PropertyInfo)
+        {
+            Hasher.Add(FString(UTF8_TO_TCHAR(PropertyInfo->Name)) + GetNamePrefix(PropertyInfo->Type) + PropertyInfo->Type->Name());
+        }
+        for (auto VariableInfo = ClassDefinition->VariableInfos; VariableInfo && VariableInfo->Name && VariableInfo->Type;
+             ++VariableInfo)
+        {
+            int Pos = VariableInfo - ClassDefinition->VariableInfos;
+            Hasher.Add((uint64) (ClassDefinition->Variables[Pos].Setter != nullptr));
+            Hasher.Add(FString(UTF8_TO_TCHAR(VariableInfo->Name)) + GetNamePrefix(VariableInfo->Type) + VariableInfo->Type->Name());
+        }
+    }
+
+    return Hasher.Finish();
+}
+
+void FTypeScriptDeclarationGenerator::PrepareTypeDeclarations(const TArray<UObject*>& Types, bool InUseCache)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    PreparedDecls.Empty();
+
+    // 只预生成原生类型,并且跳过Gen里会被过滤掉、结果依赖访问顺序(重名)或者依赖项目配置的类型,它们仍走原来的串行流程
+    TMap<FString, int32> NameCount;
+    for (UObject* Type : Types)
+    {
+        if (Type->IsNative())
+        {
+            NameCount.FindOrAdd(SafeName(Type->GetName()))++;
+        }
+    }
+
+    auto IsPreparable = [&](UObject* Type)
+    {
+        if (!Type->IsNative() || !(Type->IsA<UClass>() || Type->IsA<UScriptStruct>() || Type->IsA<UEnum>()))
+        {
+            return false;
+        }
+        if (Type->GetName().Equals(TEXT("ArrayBuffer")) || Type->GetName().Equals(TEXT("ArrayBufferValue")) ||
+            Type->GetName().Equals(TEXT("JsObject")))
+        {
+            return false;
+        }
+        if (Type == StaticEnum<EObjectTypeQuery>() || Type == StaticEnum<ETraceTypeQuery>())
+        {
+            return false;
+        }
+#if ENGINE_MAJOR_VERSION >= 5
+        if (GetNamespace(Type).Equals(TEXT("Engine.Transient")))
+        {
+            return false;
+        }
+#endif
+        return NameCount.FindRef(SafeName(Type->GetName())) == 1 && !Processed.Contains(Type);
+    };
+
+    // 按继承深度分批,同一批内的类型互不依赖可以并行生成,子类生成时需要读取父类的函数重载
+    TMap<UObject*, int32> Depths;
+    for (UObject* Type : Types)
+    {
+        if (IsPreparable(Type))
+        {
+            Depths.Add(Type, 0);
+        }
+    }
+    TArray<UObject*> Candidates;
+    int32 MaxDepth = 0;
+    for (UObject* Type : Types)
+    {
+        if (!Depths.Contains(Type))
+        {
+            continue;
+        }
+        int32 Depth = 0;
+        bool SuperPreparable = true;
+        if (auto Struct = Cast<UStruct>(Type))
+        {
+            for (UStruct* Super = Struct->GetSuperStruct(); Super; Super = Super->GetSuperStruct())
+            {
+                if (!Depths.Contains(Super))
+                {
+                    SuperPreparable = false;
+                    break;
+                }
+                ++Depth;
+            }
+        }
+        if (SuperPreparable)
+        {
+            Depths[Type] = Depth;
+            MaxDepth = FMath::Max(MaxDepth, Depth);
+            Candidates.Add(Type);
+        }
+    }
+    // 稳定排序,同一深度内保持按名字排序的顺序
+    Candidates.StableSort([&](const UObject& A, const UObject& B) { return Depths.FindChecked(const_cast<UObject*>(&A)) < Depths.FindChecked(const_cast<UObject*>(&B)); });
+
+#if WITH_EDITORONLY_DATA
+    // GetMetaData在package没有metadata时会新建,不能放到工作线程上做
+    for (TObjectIterator<UPackage> It; It; ++It)
+    {
+        if (It->HasAnyPackageFlags(PKG_CompiledIn))
+        {
+            It->GetMetaData();
+        }
+    }
+#endif
+
+    TArray<FSHAHash> OwnSignatures;
+    OwnSignatures.SetNum(Candidates.Num());
+    ParallelFor(Candidates.Num(),
+        [&](int32 Index)
+        {
+            UObject* Type = Candidates[Index];
+            auto Struct = Cast<UStruct>(Type);
+            auto ExtensionMethodsIter = Struct ? ExtensionMethodsMap.find(Struct) : ExtensionMethodsMap.end();
+            OwnSignatures[Index] =
+                HashTypeSignature(Type, ExtensionMethodsIter != ExtensionMethodsMap.end() ? &ExtensionMethodsIter->second : nullptr);
+        });
+
+    TMap<UObject*, FSHAHash> Signatures;
+    for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+    {
+        FDeclarationHasher Hasher;
+        Hasher.Add(OwnSignatures[Index]);
+        if (auto Struct = Cast<UStruct>(Candidates[Index]))
+        {
+            if (UStruct* Super = Struct->GetSuperStruct())
+            {
+                Hasher.Add(Signatures[Super]);
+            }
+        }
+        Signatures.Add(Candidates[Index], Hasher.Finish());
+    }
+
+    TMap<FString, FCachedTypeDecl> Cache;
+    if (InUseCache)
+    {
+        LoadDeclarationCache(Cache);
+    }
+
+    TArray<TArray<UObject*>> Pending;
+    Pending.SetNum(MaxDepth + 1);
+    int32 ReusedCount = 0;
+    for (UObject* Type : Candidates)
+    {
+        const FSHAHash& Signature = Signatures[Type];
+        FCachedTypeDecl* Cached = Cache.Find(Type->GetPathName());
+        if (Cached && Cached->Signature == Signature)
+        {
+            FPreparedTypeDecl Prepared;
+            Prepared.Signature = Signature;
+            bool DependenciesResolved = true;
+            for (const FString& Path : Cached->Dependencies)
+            {
+                UObject* Dependency = StaticFindObject(UObject::StaticClass(), nullptr, *Path);
+                if (!Dependency)
+                {
+                    DependenciesResolved = false;
+                    break;
+                }
+                Prepared.Dependencies.Add(Dependency);
+            }
+            if (DependenciesResolved)
+            {
+                Prepared.Decl = MoveTemp(Cached->Decl);
+                for (FCachedFunctionOverloads& Item : Cached->Functions)
+                {
+                    Prepared.Functions[FunctionKey(Item.Name, Item.IsStatic)] = MoveTemp(Item.Overloads);
+                }
+                PreparedDecls.Add(Type, MoveTemp(Prepared));
+                ++ReusedCount;
+                continue;
+            }
+        }
+        Pending[Depths[Type]].Add(Type);
+    }
+    Cache.Empty();
+
+    int32 GeneratedCount = 0;
+    const int32 NumWorkers = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1);
+    for (TArray<UObject*>& Jobs : Pending)
+    {
+        if (Jobs.Num() == 0)
+        {
+            continue;
+        }
+        TArray<FPreparedTypeDecl> Results;
+        Results.SetNum(Jobs.Num());
+        const int32 NumChunks = FMath::Min(NumWorkers, Jobs.Num());
+        ParallelFor(NumChunks,
+            [&](int32 Chunk)
+            {
+                FTypeScriptDeclarationGenerator Worker;
+                Worker.RecordOnly = true;
+                Worker.RefFromOuter = RefFromOuter;
+                Worker.ExtensionMethodsMap = ExtensionMethodsMap;
+                for (int32 Index = Chunk; Index < Jobs.Num(); Index += NumChunks)
+                {
+                    UObject* Type = Jobs[Index];
+                    FPreparedTypeDecl& Result = Results[Index];
+                    Worker.RecordedDependencies.Reset();
+                    Worker.RecordedDecl.Reset();
+
+                    if (auto Class = Cast<UClass>(Type))
+                    {
+                        for (UStruct* Super = Class->GetSuperStruct(); Super; Super = Super->GetSuperStruct())
+                        {
+                            if (Worker.AllFuncionOutputs.find(Super) == Worker.AllFuncionOutputs.end())
+                            {
+                                Worker.AllFuncionOutputs[Super] = PreparedDecls.FindChecked(Super).Functions;
+                            }
+                        }
+                        Worker.GenClass(Class);
+                    }
+                    else if (auto Struct = Cast<UStruct>(Type))
+                    {
+                        for (UStruct* Super = Struct->GetSuperStruct(); Super; Super = Super->GetSuperStruct())
+                        {
+                            if (Worker.AllFuncionOutputs.find(Super) == Worker.AllFuncionOutputs.end())
+                            {
+                                Worker.AllFuncionOutputs[Super] = PreparedDecls.FindChecked(Super).Functions;
+                            }
+                        }
+                        Worker.GenStruct(Struct);
+                    }
+                    else if (auto Enum = Cast<UEnum>(Type))
+                    {
+                        Worker.GenEnum(Enum);
+                    }
+
+                    Result.Signature = Signatures.FindChecked(Type);
+                    Result.Decl = MoveTemp(Worker.RecordedDecl);
+                    Result.Dependencies = Worker.RecordedDependencies;
+                    if (auto Struct = Cast<UStruct>(Type))
+                    {
+                        auto Iter = Worker.AllFuncionOutputs.find(Struct);
+                        if (Iter != Worker.AllFuncionOutputs.end())
+                        {
+                            Result.Functions = Iter->second;
+                        }
+                    }
+                }
+            });
+        for (int32 Index = 0; Index < Jobs.Num(); ++Index)
+        {
+            PreparedDecls.Add(Jobs[Index], MoveTemp(Results[Index]));
+        }
+        GeneratedCount += Jobs.Num();
+    }
+
+    for (auto& KV : PreparedDecls)
+    {
+        FCachedTypeDecl& Cached = Cache.Add(KV.Key->GetPathName());
+        Cached.Signature = KV.Value.Signature;
+        Cached.Decl = KV.Value.Decl;
+        for (UObject* Dependency : KV.Value.Dependencies)
+        {
+            Cached.Dependencies.Add(Dependency->GetPathName());
+        }
+        for (auto& Function : KV.Value.Functions)
+        {
+            Cached.Functions.Add({Function.first.FunctionName, Function.first.IsStatic, Function.second});
+        }
+    }
+    SaveDeclarationCache(Cache);
+
+    UE_LOG(LogTemp, Display, TEXT("prepare declarations: %d types, %d reused, %d generated on %d workers, %.3fs"),
+        Candidates.Num(), ReusedCount, GeneratedCount, NumWorkers, FPlatformTime::Seconds() - StartTime);
+}
+
 void FTypeScriptDeclarationGenerator::End()
 {
     Output.Indent(-4);
@@ -1637,6 +2237,8 @@ public:
         FTypeScriptDeclarationGenerator TypeScriptDeclarationGenerator;
         TypeScriptDeclarationGenerator.RestoreBlueprintTypeDeclInfos(InGenFull);
         TypeScriptDeclarationGenerator.LoadAllWidgetBlueprint(InSearchPath, InGenFull);
+        TypeScriptDeclarationGenerator.PrepareInParallel = true;
+        TypeScriptDeclarationGenerator.UseDeclarationCache = !InGenFull;
         TypeScriptDeclarationGenerator.GenTypeScriptDeclaration(true, true);
     }
 
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "PropertyMacros.h"
+#include "Misc/SecureHash.h"
 
 struct DECLARATIONGENERATOR_API FStringBuffer
 {
@@ -54,6 +55,24 @@ struct DECLARATIONGENERATOR_API FTypeScriptDeclarationGenerator
     typedef std::map<FunctionKey, FunctionOverloads> FunctionOutputs;
     std::map<UStruct*, FunctionOutputs> AllFuncionOutputs;
 
+    // 预先生成好的单个类型声明,来自并行生成或者增量缓存,Gen时按原来的依赖顺序回放
+    struct FPreparedTypeDecl
+    {
+        FSHAHash Signature;
+        FString Decl;
+        TArray<UObject*> Dependencies;
+        FunctionOutputs Functions;
+    };
+
+    TMap<UObject*, FPreparedTypeDecl> PreparedDecls;
+
+    // 工作线程上生成单个类型时使用:Gen只记录依赖,WriteOutput只记录声明文本
+    bool RecordOnly = false;
+
+    TArray<UObject*> RecordedDependencies;
+
+    FString RecordedDecl;
+
     std::map<UObject*, FString> NamespaceMap;
 
     std::map<UObject*, bool> PathIsValidMap;
@@ -75,6 +94,10 @@ struct DECLARATIONGENERATOR_API FTypeScriptDeclarationGenerator
 
     bool BeginGenAssetData = false;
 
+    bool PrepareInParallel = false;
+
+    bool UseDeclarationCache = false;
+
     const FString& GetNamespace(UObject* Obj);
 
     FString GetNameWithNamespace(UObject* Obj);
@@ -97,6 +120,8 @@ struct DECLARATIONGENERATOR_API FTypeScriptDeclarationGenerator
 
     void GenTypeScriptDeclaration(bool InGenStruct, bool InGenEnum);
 
+    void PrepareTypeDeclarations(const TArray<UObject*>& Types, bool InUseCache);
+
     virtual void Gen(UObject* ToGen);
 
     virtual bool GenTypeDecl(FStringBuffer& StringBuffer, PropertyMacro* Property, TArray<UObject*>& AddToGen,
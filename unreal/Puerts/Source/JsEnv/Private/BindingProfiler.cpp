@@ -0,0 +1,279 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "BindingProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace PUERTS_NAMESPACE
+{
+std::atomic<bool> FBindingProfiler::Enabled{false};
+
+std::atomic<uint64_t> FBindingProfiler::KeyEpoch{0};
+
+std::atomic<uint64_t> FBindingProfiler::ResetEpoch{0};
+
+thread_local FBindingCallScope* FBindingCallScope::Current = nullptr;
+
+namespace
+{
+// 发布后Name、HasConvertNs和Next不再修改，计数只由所属线程写入
+struct FBindingStatNode
+{
+    std::string Name;
+    bool HasConvertNs;
+    std::atomic<uint64_t> Calls{0};
+    std::atomic<uint64_t> TotalNs{0};
+    std::atomic<uint64_t> ConvertNs{0};
+    FBindingStatNode* Next = nullptr;
+};
+
+inline void AddCounter(std::atomic<uint64_t>& Counter, uint64_t Value)
+{
+    // 只有所属线程写，不需要原子加
+    Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+}
+
+struct FThreadBindingTable
+{
+    ~FThreadBindingTable()
+    {
+        FBindingStatNode* Node = Head.load(std::memory_order_relaxed);
+        while (Node)
+        {
+            FBindingStatNode* Next = Node->Next;
+            delete Node;
+            Node = Next;
+        }
+    }
+
+    // 以下只由所属线程访问
+    std::unordered_map<const void*, FBindingStatNode*> ByKey;
+    std::unordered_map<std::string, FBindingStatNode*> ByName;
+    uint64_t SeenKeyEpoch = 0;
+
+    // 汇总时从这里遍历，节点只增不删
+    std::atomic<FBindingStatNode*> Head{nullptr};
+
+    // 计数在该Reset轮次之后有效，汇总时跳过轮次落后的表
+    std::atomic<uint64_t> ValidResetEpoch{0};
+};
+
+struct FBindingTableRegistry
+{
+    std::mutex Lock;
+    // 线程退出后表仍保留，数据不会丢失
+    std::vector<std::shared_ptr<FThreadBindingTable>> Tables;
+};
+
+FBindingTableRegistry& GetBindingTableRegistry()
+{
+    static FBindingTableRegistry Registry;
+    return Registry;
+}
+
+FThreadBindingTable& GetThreadBindingTable()
+{
+    thread_local std::shared_ptr<FThreadBindingTable> Table;
+    if (!Table)
+    {
+        Table = std::make_shared<FThreadBindingTable>();
+        auto& Registry = GetBindingTableRegistry();
+        std::lock_guard<std::mutex> Guard(Registry.Lock);
+        Registry.Tables.push_back(Table);
+    }
+    return *Table;
+}
+
+void AppendBindingJsonString(std::string& Out, const std::string& Str)
+{
+    Out += '"';
+    for (char C : Str)
+    {
+        switch (C)
+        {
+            case '"':
+                Out += "\\\"";
+                break;
+            case '\\':
+                Out += "\\\\";
+                break;
+            case '\n':
+                Out += "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(C) < 0x20)
+                {
+                    char Buf[8];
+                    snprintf(Buf, sizeof(Buf), "\\u%04x", C);
+                    Out += Buf;
+                }
+                else
+                {
+                    Out += C;
+                }
+        }
+    }
+    Out += '"';
+}
+}    // namespace
+
+void FBindingProfiler::SetEnabled(bool InEnabled)
+{
+    Enabled.store(InEnabled, std::memory_order_relaxed);
+}
+
+void FBindingProfiler::Record(const void* Key, BindingNameFunc GetName, uint64_t TotalNs, uint64_t ConvertNs)
+{
+    RecordImpl(Key, GetName, TotalNs, ConvertNs, true);
+}
+
+void FBindingProfiler::RecordWithoutConvert(const void* Key, BindingNameFunc GetName, uint64_t TotalNs, uint64_t ConvertNs)
+{
+    RecordImpl(Key, GetName, TotalNs, 0, false);
+}
+
+void FBindingProfiler::RecordImpl(
+    const void* Key, BindingNameFunc GetName, uint64_t TotalNs, uint64_t ConvertNs, bool HasConvertNs)
+{
+    auto& Table = GetThreadBindingTable();
+
+    const uint64_t CurrentResetEpoch = ResetEpoch.load(std::memory_order_acquire);
+    if (Table.ValidResetEpoch.load(std::memory_order_relaxed) != CurrentResetEpoch)
+    {
+        for (FBindingStatNode* Node = Table.Head.load(std::memory_order_relaxed); Node; Node = Node->Next)
+        {
+            Node->Calls.store(0, std::memory_order_relaxed);
+            Node->TotalNs.store(0, std::memory_order_relaxed);
+            Node->ConvertNs.store(0, std::memory_order_relaxed);
+        }
+        Table.ValidResetEpoch.store(CurrentResetEpoch, std::memory_order_release);
+    }
+
+    const uint64_t CurrentKeyEpoch = KeyEpoch.load(std::memory_order_relaxed);
+    if (Table.SeenKeyEpoch != CurrentKeyEpoch)
+    {
+        // 有Key被释放，地址可能已被复用，重新按名字查找
+        Table.ByKey.clear();
+        Table.SeenKeyEpoch = CurrentKeyEpoch;
+    }
+
+    FBindingStatNode* Node;
+    auto Iter = Table.ByKey.find(Key);
+    if (Iter != Table.ByKey.end())
+    {
+        Node = Iter->second;
+    }
+    else
+    {
+        const char* NamePtr = GetName ? GetName(Key) : nullptr;
+        std::string Name = NamePtr ? NamePtr : "<unknown>";
+        auto NameIter = Table.ByName.find(Name);
+        if (NameIter != Table.ByName.end())
+        {
+            Node = NameIter->second;
+        }
+        else
+        {
+            Node = new FBindingStatNode();
+            Node->Name = Name;
+            Node->HasConvertNs = HasConvertNs;
+            Node->Next = Table.Head.load(std::memory_order_relaxed);
+            Table.Head.store(Node, std::memory_order_release);
+            Table.ByName.emplace(std::move(Name), Node);
+        }
+        Table.ByKey.emplace(Key, Node);
+    }
+
+    AddCounter(Node->Calls, 1);
+    AddCounter(Node->TotalNs, TotalNs);
+    AddCounter(Node->ConvertNs, ConvertNs);
+}
+
+std::vector<FBindingStat> FBindingProfiler::Snapshot()
+{
+    std::map<std::string, FBindingStat> Merged;
+    const uint64_t CurrentResetEpoch = ResetEpoch.load(std::memory_order_acquire);
+    auto& Registry = GetBindingTableRegistry();
+    std::lock_guard<std::mutex> RegistryGuard(Registry.Lock);
+    for (auto& Table : Registry.Tables)
+    {
+        // 还没处理最近一次Reset的表视为已清零
+        if (Table->ValidResetEpoch.load(std::memory_order_acquire) != CurrentResetEpoch)
+        {
+            continue;
+        }
+        for (FBindingStatNode* Node = Table->Head.load(std::memory_order_acquire); Node; Node = Node->Next)
+        {
+            const uint64_t Calls = Node->Calls.load(std::memory_order_relaxed);
+            if (Calls == 0)
+            {
+                continue;
+            }
+            auto& Stat = Merged[Node->Name];
+            if (Stat.Name.empty())
+            {
+                Stat.Name = Node->Name;
+                Stat.HasConvertNs = false;
+            }
+            Stat.HasConvertNs = Stat.HasConvertNs || Node->HasConvertNs;
+            Stat.Calls += Calls;
+            Stat.TotalNs += Node->TotalNs.load(std::memory_order_relaxed);
+            Stat.ConvertNs += Node->ConvertNs.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<FBindingStat> Result;
+    Result.reserve(Merged.size());
+    for (auto& KV : Merged)
+    {
+        Result.push_back(std::move(KV.second));
+    }
+    std::sort(Result.begin(), Result.end(), [](const FBindingStat& A, const FBindingStat& B) { return A.TotalNs > B.TotalNs; });
+    return Result;
+}
+
+void FBindingProfiler::Reset()
+{
+    // 各线程下次记录时自己清零，这里不碰其它线程的计数
+    ResetEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::string FBindingProfiler::ToJson(size_t MaxEntries)
+{
+    auto Stats = Snapshot();
+    if (MaxEntries > 0 && Stats.size() > MaxEntries)
+    {
+        Stats.resize(MaxEntries);
+    }
+    std::string Out = "[";
+    char Buf[128];
+    for (size_t i = 0; i < Stats.size(); ++i)
+    {
+        const auto& Stat = Stats[i];
+        Out += i == 0 ? "\n  {\"name\": " : ",\n  {\"name\": ";
+        AppendBindingJsonString(Out, Stat.Name);
+        snprintf(Buf, sizeof(Buf), ", \"calls\": %llu, \"total_ns\": %llu", static_cast<unsigned long long>(Stat.Calls),
+            static_cast<unsigned long long>(Stat.TotalNs));
+        Out += Buf;
+        if (Stat.HasConvertNs)
+        {
+            snprintf(Buf, sizeof(Buf), ", \"convert_ns\": %llu", static_cast<unsigned long long>(Stat.ConvertNs));
+            Out += Buf;
+        }
+        Out += '}';
+    }
+    Out += Stats.empty() ? "]" : "\n]";
+    return Out;
+}
+}    // namespace PUERTS_NAMESPACE
@@ -0,0 +1,150 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if !defined(PUERTS_NAMESPACE)
+#if defined(WITH_QJS_NAMESPACE_SUFFIX)
+#define PUERTS_NAMESPACE puerts_qjs
+#else
+#define PUERTS_NAMESPACE puerts
+#endif
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+// 只在某个绑定第一次被记录时调用，返回的字符串需在调用线程内保持有效
+typedef const char* (*BindingNameFunc)(const void* Key);
+
+struct FBindingStat
+{
+    std::string Name;
+    uint64_t Calls = 0;
+    // 绑定调用的总耗时（包含嵌套调用）
+    uint64_t TotalNs = 0;
+    // 参数、返回值转换的耗时，即总耗时减去目标函数本身的执行时间
+    uint64_t ConvertNs = 0;
+    // 调用方无法单独计时转换时为false，报告中不输出convert_ns
+    bool HasConvertNs = true;
+};
+
+// 按绑定统计调用次数和耗时，默认关闭
+// 计数写在各线程自己的表里，记录时不加锁，只有汇总报告时才遍历所有线程的表
+// 报告按名字合并，Key只用于线程内快速查找；Key对应的对象释放时需调用NotifyKeyReleased，避免地址复用后记到旧名字下
+class FBindingProfiler
+{
+public:
+    static bool IsEnabled()
+    {
+        return Enabled.load(std::memory_order_relaxed);
+    }
+
+    static void SetEnabled(bool InEnabled);
+
+    static uint64_t NowNs()
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static void Record(const void* Key, BindingNameFunc GetName, uint64_t TotalNs, uint64_t ConvertNs);
+
+    // 签名与Record相同，忽略ConvertNs
+    static void RecordWithoutConvert(const void* Key, BindingNameFunc GetName, uint64_t TotalNs, uint64_t ConvertNs);
+
+    static void NotifyKeyReleased(const void* Key)
+    {
+        if (IsEnabled())
+        {
+            KeyEpoch.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // 合并所有线程的计数，按总耗时降序排列
+    static std::vector<FBindingStat> Snapshot();
+
+    static void Reset();
+
+    // MaxEntries为0时输出全部
+    static std::string ToJson(size_t MaxEntries = 0);
+
+private:
+    static void RecordImpl(const void* Key, BindingNameFunc GetName, uint64_t TotalNs, uint64_t ConvertNs, bool HasConvertNs);
+
+    static std::atomic<bool> Enabled;
+
+    // 有Key被释放时递增，各线程看到变化后清空自己的Key查找表
+    static std::atomic<uint64_t> KeyEpoch;
+
+    // Reset时递增，各线程看到变化后清零自己的计数
+    static std::atomic<uint64_t> ResetEpoch;
+};
+
+// 在绑定入口处构造，关闭时只有一次原子读的开销
+class FBindingCallScope
+{
+public:
+    FBindingCallScope(const void* InKey, BindingNameFunc InGetName)
+    {
+        if (FBindingProfiler::IsEnabled())
+        {
+            Key = InKey;
+            GetName = InGetName;
+            Parent = Current;
+            Current = this;
+            Start = FBindingProfiler::NowNs();
+        }
+    }
+
+    ~FBindingCallScope()
+    {
+        if (Key)
+        {
+            uint64_t Total = FBindingProfiler::NowNs() - Start;
+            Current = Parent;
+            FBindingProfiler::Record(Key, GetName, Total, Total > CallNs ? Total - CallNs : 0);
+        }
+    }
+
+    // 包住目标函数本身的执行，其余时间计为转换开销
+    static void BeginTargetCall()
+    {
+        if (Current)
+        {
+            Current->CallStart = FBindingProfiler::NowNs();
+        }
+    }
+
+    static void EndTargetCall()
+    {
+        if (Current)
+        {
+            Current->CallNs += FBindingProfiler::NowNs() - Current->CallStart;
+        }
+    }
+
+    FBindingCallScope(const FBindingCallScope&) = delete;
+    FBindingCallScope& operator=(const FBindingCallScope&) = delete;
+
+private:
+    const void* Key = nullptr;
+    BindingNameFunc GetName = nullptr;
+    FBindingCallScope* Parent = nullptr;
+    uint64_t Start = 0;
+    uint64_t CallStart = 0;
+    uint64_t CallNs = 0;
+
+    static thread_local FBindingCallScope* Current;
+};
+}    // namespace PUERTS_NAMESPACE
@@ -15,7 +15,7 @@ v8::Local<v8::FunctionTemplate> FScriptArrayWrapper::ToFunctionTemplate(v8::Isol
 {
     v8::Isolate::Scope Isolatescope(Isolate);
     auto Result = v8::FunctionTemplate::New(Isolate, New);
-    Result->InstanceTemplate()->SetInternalFieldCount(4);    // 0 Ptr, 1 Property
+    Result->InstanceTemplate()->SetInternalFieldCount(6);    // 0 Ptr, 1 Property, 2 HashIndex
 
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Num"), v8::FunctionTemplate::New(Isolate, Num));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Add"), v8::FunctionTemplate::New(Isolate, Add));
@@ -28,6 +28,10 @@ v8::Local<v8::FunctionTemplate> FScriptArrayWrapper::ToFunctionTemplate(v8::Isol
     Result->PrototypeTemplate()->Set(
         FV8Utils::InternalString(Isolate, "IsValidIndex"), v8::FunctionTemplate::New(Isolate, IsValidIndex));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Empty"), v8::FunctionTemplate::New(Isolate, Empty));
+    Result->PrototypeTemplate()->Set(
+        FV8Utils::InternalString(Isolate, "EnableHashIndex"), v8::FunctionTemplate::New(Isolate, EnableHashIndex));
+    Result->PrototypeTemplate()->Set(
+        FV8Utils::InternalString(Isolate, "InvalidateHashIndex"), v8::FunctionTemplate::New(Isolate, InvalidateHashIndex));
 
     return Result;
 }
@@ -35,6 +39,7 @@ v8::Local<v8::FunctionTemplate> FScriptArrayWrapper::ToFunctionTemplate(v8::Isol
 void FScriptArrayWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -48,6 +53,7 @@ void FScriptArrayWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
             return;
         }
 
+        MarkMutated(Info.Holder());
         int32 Index = AddUninitialized(Self, GetSizeWithAlignment(Inner->Property), Info.Length());
         for (int i = 0; i < Info.Length(); ++i)
         {
@@ -62,6 +68,7 @@ void FScriptArrayWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FScriptArrayWrapper::InternalGet(const v8::FunctionCallbackInfo<v8::Value>& Info, bool PassByPointer)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -103,6 +110,7 @@ void FScriptArrayWrapper::GetRef(const v8::FunctionCallbackInfo<v8::Value>& Info
 void FScriptArrayWrapper::Set(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -122,6 +130,7 @@ void FScriptArrayWrapper::Set(const v8::FunctionCallbackInfo<v8::Value>& Info)
         FV8Utils::ThrowException(Isolate, TEXT("invalid index"));
         return;
     }
+    MarkMutated(Info.Holder());
     uint8* DataPtr = GetData(Self, GetSizeWithAlignment(Inner->Property), Index);
     Inner->Property->InitializeValue(DataPtr);
     Inner->JsToUE(Isolate, Context, Info[1], DataPtr, false);
@@ -129,6 +138,7 @@ void FScriptArrayWrapper::Set(const v8::FunctionCallbackInfo<v8::Value>& Info)
 
 void FScriptArrayWrapper::Contains(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
+    CHECK_UE_ACCESS_THREAD(Info.GetIsolate());
     CHECK_V8_ARGS_LEN(1);
     bool Result = FindIndexInner(Info) != INDEX_NONE;
     Info.GetReturnValue().Set(Result);
@@ -136,6 +146,7 @@ void FScriptArrayWrapper::Contains(const v8::FunctionCallbackInfo<v8::Value>& In
 
 void FScriptArrayWrapper::FindIndex(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
+    CHECK_UE_ACCESS_THREAD(Info.GetIsolate());
     CHECK_V8_ARGS_LEN(1);
     int32 Result = FindIndexInner(Info);
     Info.GetReturnValue().Set(Result);
@@ -144,6 +155,7 @@ void FScriptArrayWrapper::FindIndex(const v8::FunctionCallbackInfo<v8::Value>& I
 void FScriptArrayWrapper::RemoveAt(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -165,6 +177,7 @@ void FScriptArrayWrapper::RemoveAt(const v8::FunctionCallbackInfo<v8::Value>& In
     }
     else
     {
+        MarkMutated(Info.Holder());
         FScriptArrayEx::Destruct(Self, Inner->Property, Index, 1);
 #if ENGINE_MAJOR_VERSION > 4
         Self->Remove(Index, 1, GetSizeWithAlignment(Inner->Property), __STDCPP_DEFAULT_NEW_ALIGNMENT__);
@@ -177,6 +190,7 @@ void FScriptArrayWrapper::RemoveAt(const v8::FunctionCallbackInfo<v8::Value>& In
 void FScriptArrayWrapper::IsValidIndex(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -190,6 +204,7 @@ void FScriptArrayWrapper::IsValidIndex(const v8::FunctionCallbackInfo<v8::Value>
 void FScriptArrayWrapper::Empty(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -201,9 +216,56 @@ void FScriptArrayWrapper::Empty(const v8::FunctionCallbackInfo<v8::Value>& Info)
         return;
     }
 
+    MarkMutated(Info.Holder());
     FScriptArrayEx::Empty(Self, Inner->Property);
 }
 
+void FScriptArrayWrapper::EnableHashIndex(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptArray>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+
+    if (!Inner->Property->HasAnyPropertyFlags(CPF_HasGetValueTypeHash))
+    {
+        FV8Utils::ThrowException(Isolate, "item type is not hashable!");
+        return;
+    }
+
+    if (FV8Utils::GetPointerFast<FScriptArrayHashIndex>(Info.Holder(), 2))
+    {
+        return;
+    }
+
+    auto HashIndex = FV8Utils::IsolateData<IObjectMapper>(Isolate)->AddArrayHashIndex(Self);
+    if (HashIndex)
+    {
+        DataTransfer::SetPointer(Isolate, Info.Holder(), HashIndex, 2);
+    }
+}
+
+void FScriptArrayWrapper::InvalidateHashIndex(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    CHECK_UE_ACCESS_THREAD(Info.GetIsolate());
+    MarkMutated(Info.Holder());
+}
+
+FORCEINLINE void FScriptArrayWrapper::MarkMutated(v8::Local<v8::Object> Holder)
+{
+    if (auto HashIndex = FV8Utils::GetPointerFast<FScriptArrayHashIndex>(Holder, 2))
+    {
+        HashIndex->Invalidate();
+    }
+}
+
 FORCEINLINE int32 FScriptArrayWrapper::AddUninitialized(FScriptArray* ScriptArray, int32 ElementSize, int32 Count)
 {
 #if ENGINE_MAJOR_VERSION > 4
@@ -248,21 +310,69 @@ int32 FScriptArrayWrapper::FindIndexInner(const v8::FunctionCallbackInfo<v8::Val
     Property->InitializeValue(Dest);
     Inner->JsToUE(Isolate, Context, Info[0], Dest, false);
 
-    const int32 Num = Self->Num();
     int32 Result = INDEX_NONE;
-    for (int32 i = 0; i < Num; ++i)
+    if (auto HashIndex = FV8Utils::GetPointerFast<FScriptArrayHashIndex>(Info.Holder(), 2))
     {
-        uint8* Src = GetData(Self, GetSizeWithAlignment(Property), i);
-        if (Property->Identical(Src, Dest))
+        Result = HashIndex->Find(Self, Property, Dest);
+    }
+    else
+    {
+        const int32 Num = Self->Num();
+        for (int32 i = 0; i < Num; ++i)
         {
-            Result = i;
-            break;
+            uint8* Src = GetData(Self, GetSizeWithAlignment(Property), i);
+            if (Property->Identical(Src, Dest))
+            {
+                Result = i;
+                break;
+            }
         }
     }
     Property->DestroyValue(Dest);
     return Result;
 }
 
+void FScriptArrayHashIndex::Rebuild(const FScriptArray* ScriptArray, PropertyMacro* Property)
+{
+    const int32 ElementSize = GetSizeWithAlignment(Property);
+    const int32 Num = ScriptArray->Num();
+    const uint8* Data = static_cast<const uint8*>(ScriptArray->GetData());
+
+    Buckets.Reset();
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Buckets.FindOrAdd(Property->GetValueTypeHash(Data + i * ElementSize)).Add(i);
+    }
+
+    BuiltMutationCount = MutationCount;
+    BuiltData = ScriptArray->GetData();
+    BuiltNum = Num;
+}
+
+int32 FScriptArrayHashIndex::Find(const FScriptArray* ScriptArray, PropertyMacro* Property, const void* Value)
+{
+    // C++侧的增删会改变数据地址或长度，也视为失效
+    if (BuiltMutationCount != MutationCount || BuiltData != ScriptArray->GetData() || BuiltNum != ScriptArray->Num())
+    {
+        Rebuild(ScriptArray, Property);
+    }
+
+    const TArray<int32>* Indexes = Buckets.Find(Property->GetValueTypeHash(Value));
+    if (Indexes)
+    {
+        const int32 ElementSize = GetSizeWithAlignment(Property);
+        const uint8* Data = static_cast<const uint8*>(ScriptArray->GetData());
+        for (int32 Index : *Indexes)
+        {
+            if (Property->Identical(Data + Index * ElementSize, Value))
+            {
+                return Index;
+            }
+        }
+    }
+    return INDEX_NONE;
+}
+
 //---------------------------------------Set-----------------------------------------------
 
 v8::Local<v8::FunctionTemplate> FScriptSetWrapper::ToFunctionTemplate(v8::Isolate* Isolate)
@@ -290,6 +400,7 @@ v8::Local<v8::FunctionTemplate> FScriptSetWrapper::ToFunctionTemplate(v8::Isolat
 void FScriptSetWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -324,6 +435,7 @@ void FScriptSetWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FScriptSetWrapper::InternalGet(const v8::FunctionCallbackInfo<v8::Value>& Info, bool PassByPointer)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -368,6 +480,7 @@ void FScriptSetWrapper::GetRef(const v8::FunctionCallbackInfo<v8::Value>& Info)
 
 void FScriptSetWrapper::Contains(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
+    CHECK_UE_ACCESS_THREAD(Info.GetIsolate());
     CHECK_V8_ARGS_LEN(1);
     bool Result = FindIndexInner(Info) != INDEX_NONE;
     Info.GetReturnValue().Set(Result);
@@ -375,6 +488,7 @@ void FScriptSetWrapper::Contains(const v8::FunctionCallbackInfo<v8::Value>& Info
 
 void FScriptSetWrapper::FindIndex(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
+    CHECK_UE_ACCESS_THREAD(Info.GetIsolate());
     CHECK_V8_ARGS_LEN(1);
     int32 Result = FindIndexInner(Info);
     Info.GetReturnValue().Set(Result);
@@ -383,6 +497,7 @@ void FScriptSetWrapper::FindIndex(const v8::FunctionCallbackInfo<v8::Value>& Inf
 void FScriptSetWrapper::RemoveAt(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -414,6 +529,7 @@ void FScriptSetWrapper::RemoveAt(const v8::FunctionCallbackInfo<v8::Value>& Info
 void FScriptSetWrapper::GetMaxIndex(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -425,6 +541,7 @@ void FScriptSetWrapper::GetMaxIndex(const v8::FunctionCallbackInfo<v8::Value>& I
 void FScriptSetWrapper::IsValidIndex(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -439,6 +556,7 @@ void FScriptSetWrapper::IsValidIndex(const v8::FunctionCallbackInfo<v8::Value>&
 void FScriptSetWrapper::Empty(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -508,6 +626,7 @@ v8::Local<v8::FunctionTemplate> FScriptMapWrapper::ToFunctionTemplate(v8::Isolat
 void FScriptMapWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -559,6 +678,7 @@ void FScriptMapWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FScriptMapWrapper::InternalGet(const v8::FunctionCallbackInfo<v8::Value>& Info, bool PassByPointer)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -616,6 +736,7 @@ void FScriptMapWrapper::Set(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FScriptMapWrapper::Remove(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -655,6 +776,7 @@ void FScriptMapWrapper::Remove(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FScriptMapWrapper::GetMaxIndex(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -666,6 +788,7 @@ void FScriptMapWrapper::GetMaxIndex(const v8::FunctionCallbackInfo<v8::Value>& I
 void FScriptMapWrapper::IsValidIndex(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -679,6 +802,7 @@ void FScriptMapWrapper::IsValidIndex(const v8::FunctionCallbackInfo<v8::Value>&
 void FScriptMapWrapper::GetKey(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -713,6 +837,7 @@ void FScriptMapWrapper::GetKey(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FScriptMapWrapper::Empty(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -755,6 +880,7 @@ v8::Local<v8::FunctionTemplate> FFixSizeArrayWrapper::ToFunctionTemplate(v8::Iso
 void FFixSizeArrayWrapper::Num(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -770,6 +896,7 @@ void FFixSizeArrayWrapper::Num(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FFixSizeArrayWrapper::InternalGet(const v8::FunctionCallbackInfo<v8::Value>& Info, bool PassByPointer)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -818,6 +945,7 @@ void FFixSizeArrayWrapper::GetRef(const v8::FunctionCallbackInfo<v8::Value>& Inf
 void FFixSizeArrayWrapper::Set(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -234,6 +234,33 @@ struct ContainerExTypeMapper<FScriptMap>
     using Type = FScriptMapEx;
 };
 
+// TArray的可选哈希索引，由脚本调用EnableHashIndex开启，用于加速Contains/FindIndex
+// 通过wrapper进行的修改会递增MutationCount，索引在下次查询时惰性重建
+// 读取不会使索引失效，所以通过GetRef拿到的引用修改元素，或在C++侧原地修改元素后，需要脚本调用InvalidateHashIndex
+struct FScriptArrayHashIndex
+{
+    uint32 MutationCount = 0;
+
+    int32 Find(const FScriptArray* ScriptArray, PropertyMacro* Property, const void* Value);
+
+    FORCEINLINE void Invalidate()
+    {
+        ++MutationCount;
+    }
+
+private:
+    void Rebuild(const FScriptArray* ScriptArray, PropertyMacro* Property);
+
+    uint32 BuiltMutationCount = MAX_uint32;
+
+    const void* BuiltData = nullptr;
+
+    int32 BuiltNum = INDEX_NONE;
+
+    // 每个桶中的索引按升序排列，以保证FindIndex返回第一次出现的位置
+    TMap<uint32, TArray<int32>> Buckets;
+};
+
 template <typename T>
 class FContainerWrapper
 {
@@ -266,6 +293,7 @@ public:
     static void Num(const v8::FunctionCallbackInfo<v8::Value>& Info)
     {
         v8::Isolate* Isolate = Info.GetIsolate();
+        CHECK_UE_ACCESS_THREAD(Isolate);
         v8::HandleScope HandleScope(Isolate);
         v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
@@ -325,6 +353,18 @@ private:
     // 作用：清空容器
     static void Empty(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    // 参数：无
+    // 返回：无
+    // 作用：为容器建立哈希索引，之后Contains/FindIndex为O(1)，元素类型不支持哈希则抛出异常
+    static void EnableHashIndex(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：无
+    // 返回：无
+    // 作用：在C++侧修改了容器元素后，通知哈希索引失效
+    static void InvalidateHashIndex(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    FORCEINLINE static void MarkMutated(v8::Local<v8::Object> Holder);
+
     FORCEINLINE static int32 AddUninitialized(FScriptArray* ScriptArray, int32 ElementSize, int32 Count = 1);
 
     FORCEINLINE static uint8* GetData(FScriptArray* ScriptArray, int32 ElementSize, int32 Index);
@@ -0,0 +1,222 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "CpuProfileRecorder.h"
+
+#if !defined(WITH_QUICKJS)
+
+#include <cstdio>
+#include <set>
+
+#ifndef PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#define PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#define PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#endif
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#include "v8-profiler.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+namespace PUERTS_NAMESPACE
+{
+namespace
+{
+void AppendProfileJsonString(std::string& Out, const char* Str)
+{
+    Out += '"';
+    for (const char* P = Str; P && *P; ++P)
+    {
+        char C = *P;
+        if (C == '"' || C == '\\')
+        {
+            Out += '\\';
+            Out += C;
+        }
+        else if (static_cast<unsigned char>(C) < 0x20)
+        {
+            char Buf[8];
+            snprintf(Buf, sizeof(Buf), "\\u%04x", C);
+            Out += Buf;
+        }
+        else
+        {
+            Out += C;
+        }
+    }
+    Out += '"';
+}
+
+// .cpuprofile格式：扁平的节点数组，子节点用id引用；行列号从0开始
+void AppendProfileNode(std::string& Out, const v8::CpuProfileNode* Node, bool& First)
+{
+    Out += First ? "\n{" : ",\n{";
+    First = false;
+    Out += "\"id\":" + std::to_string(Node->GetNodeId());
+    Out += ",\"callFrame\":{\"functionName\":";
+    AppendProfileJsonString(Out, Node->GetFunctionNameStr());
+    Out += ",\"scriptId\":\"" + std::to_string(Node->GetScriptId()) + "\",\"url\":";
+    AppendProfileJsonString(Out, Node->GetScriptResourceNameStr());
+    Out += ",\"lineNumber\":" + std::to_string(Node->GetLineNumber() - 1);
+    Out += ",\"columnNumber\":" + std::to_string(Node->GetColumnNumber() - 1);
+    Out += "},\"hitCount\":" + std::to_string(Node->GetHitCount());
+    const int ChildrenCount = Node->GetChildrenCount();
+    if (ChildrenCount > 0)
+    {
+        Out += ",\"children\":[";
+        for (int i = 0; i < ChildrenCount; ++i)
+        {
+            if (i > 0)
+            {
+                Out += ',';
+            }
+            Out += std::to_string(Node->GetChild(i)->GetNodeId());
+        }
+        Out += ']';
+    }
+    Out += '}';
+    for (int i = 0; i < ChildrenCount; ++i)
+    {
+        AppendProfileNode(Out, Node->GetChild(i), First);
+    }
+}
+
+std::string SerializeProfile(const v8::CpuProfile* Profile)
+{
+    std::string Out = "{\"nodes\":[";
+    bool First = true;
+    AppendProfileNode(Out, Profile->GetTopDownRoot(), First);
+    Out += "],\n\"startTime\":" + std::to_string(Profile->GetStartTime());
+    Out += ",\"endTime\":" + std::to_string(Profile->GetEndTime());
+
+    const int SamplesCount = Profile->GetSamplesCount();
+    Out += ",\n\"samples\":[";
+    for (int i = 0; i < SamplesCount; ++i)
+    {
+        if (i > 0)
+        {
+            Out += ',';
+        }
+        Out += std::to_string(Profile->GetSample(i)->GetNodeId());
+    }
+    Out += "],\n\"timeDeltas\":[";
+    int64_t LastTimestamp = Profile->GetStartTime();
+    for (int i = 0; i < SamplesCount; ++i)
+    {
+        int64_t Timestamp = Profile->GetSampleTimestamp(i);
+        if (i > 0)
+        {
+            Out += ',';
+        }
+        Out += std::to_string(Timestamp - LastTimestamp);
+        LastTimestamp = Timestamp;
+    }
+    Out += "]}\n";
+    return Out;
+}
+
+class FCpuProfileRecorder : public ICpuProfileRecorder
+{
+public:
+    explicit FCpuProfileRecorder(v8::Isolate* InIsolate) : Isolate(InIsolate), Profiler(v8::CpuProfiler::New(InIsolate))
+    {
+    }
+
+    ~FCpuProfileRecorder() override
+    {
+        v8::HandleScope HandleScope(Isolate);
+        for (auto& Title : ActiveTitles)
+        {
+            auto Profile = Profiler->StopProfiling(ToV8(Title));
+            if (Profile)
+            {
+                Profile->Delete();
+            }
+        }
+        Profiler->Dispose();
+    }
+
+    bool Start(const std::string& Title, int SamplingIntervalUs) override
+    {
+        if (ActiveTitles.count(Title) > 0)
+        {
+            return false;
+        }
+        if (SamplingIntervalUs > 0)
+        {
+            // 只能在没有进行中的采样时修改
+            if (ActiveTitles.empty())
+            {
+                Profiler->SetSamplingInterval(SamplingIntervalUs);
+            }
+        }
+        v8::HandleScope HandleScope(Isolate);
+        Profiler->StartProfiling(ToV8(Title), true);
+        ActiveTitles.insert(Title);
+        return true;
+    }
+
+    bool Stop(const std::string& Title, const std::string& OutputPath) override
+    {
+        if (ActiveTitles.erase(Title) == 0)
+        {
+            return false;
+        }
+        v8::HandleScope HandleScope(Isolate);
+        v8::CpuProfile* Profile = Profiler->StopProfiling(ToV8(Title));
+        if (!Profile)
+        {
+            return false;
+        }
+        std::string Json = SerializeProfile(Profile);
+        Profile->Delete();
+
+        FILE* File = fopen(OutputPath.c_str(), "wb");
+        if (!File)
+        {
+            return false;
+        }
+        bool Success = fwrite(Json.data(), 1, Json.size(), File) == Json.size();
+        fclose(File);
+        return Success;
+    }
+
+private:
+    v8::Local<v8::String> ToV8(const std::string& Str)
+    {
+        return v8::String::NewFromUtf8(Isolate, Str.c_str(), v8::NewStringType::kNormal, static_cast<int>(Str.size()))
+            .ToLocalChecked();
+    }
+
+    v8::Isolate* Isolate;
+
+    v8::CpuProfiler* Profiler;
+
+    std::set<std::string> ActiveTitles;
+};
+}    // namespace
+
+ICpuProfileRecorder* CreateCpuProfileRecorder(void* InIsolate)
+{
+    return new FCpuProfileRecorder(static_cast<v8::Isolate*>(InIsolate));
+}
+}    // namespace PUERTS_NAMESPACE
+
+#else
+
+namespace PUERTS_NAMESPACE
+{
+ICpuProfileRecorder* CreateCpuProfileRecorder(void* InIsolate)
+{
+    return nullptr;
+}
+}    // namespace PUERTS_NAMESPACE
+
+#endif
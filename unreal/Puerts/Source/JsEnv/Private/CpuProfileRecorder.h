@@ -0,0 +1,39 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <string>
+
+#if !defined(PUERTS_NAMESPACE)
+#if defined(WITH_QJS_NAMESPACE_SUFFIX)
+#define PUERTS_NAMESPACE puerts_qjs
+#else
+#define PUERTS_NAMESPACE puerts
+#endif
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+// 对v8::CpuProfiler的封装，停止时把结果写成Chrome DevTools可直接加载的.cpuprofile文件
+class ICpuProfileRecorder
+{
+public:
+    // SamplingIntervalUs小于等于0时使用v8默认采样间隔
+    virtual bool Start(const std::string& Title, int SamplingIntervalUs) = 0;
+
+    virtual bool Stop(const std::string& Title, const std::string& OutputPath) = 0;
+
+    virtual ~ICpuProfileRecorder()
+    {
+    }
+};
+
+// 接受v8::Isolate指针，必须在该Isolate所在线程调用；不支持的后端（如QuickJS）返回nullptr
+ICpuProfileRecorder* CreateCpuProfileRecorder(void* InIsolate);
+}    // namespace PUERTS_NAMESPACE
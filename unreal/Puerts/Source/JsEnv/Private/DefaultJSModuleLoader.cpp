@@ -138,6 +138,16 @@ bool DefaultJSModuleLoader::Load(const FString& Path, TArray<uint8>& Content)
     return false;
 }
 
+IMappedFileHandle* DefaultJSModuleLoader::OpenMapped(const FString& Path)
+{
+#if WITH_EDITOR
+    // windows下被映射的文件无法写入，会导致编辑器里重新生成js失败
+    return nullptr;
+#else
+    return MapFiles ? FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path) : nullptr;
+#endif
+}
+
 FString& DefaultJSModuleLoader::GetScriptRoot()
 {
     return ScriptRoot;
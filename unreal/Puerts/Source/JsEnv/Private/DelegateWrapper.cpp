@@ -32,6 +32,7 @@ void FDelegateWrapper::New(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FDelegateWrapper::IsBound(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -45,6 +46,7 @@ void FDelegateWrapper::IsBound(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FDelegateWrapper::Bind(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -79,6 +81,7 @@ void FDelegateWrapper::Bind(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FDelegateWrapper::Unbind(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -91,6 +94,7 @@ void FDelegateWrapper::Unbind(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FDelegateWrapper::Execute(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -120,6 +124,7 @@ void FMulticastDelegateWrapper::New(const v8::FunctionCallbackInfo<v8::Value>& I
 void FMulticastDelegateWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -168,6 +173,7 @@ void FMulticastDelegateWrapper::Add(const v8::FunctionCallbackInfo<v8::Value>& I
 void FMulticastDelegateWrapper::Remove(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -188,6 +194,7 @@ void FMulticastDelegateWrapper::Remove(const v8::FunctionCallbackInfo<v8::Value>
 void FMulticastDelegateWrapper::Clear(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -200,6 +207,7 @@ void FMulticastDelegateWrapper::Clear(const v8::FunctionCallbackInfo<v8::Value>&
 void FMulticastDelegateWrapper::Broadcast(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -0,0 +1,108 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "ExternalSourceResource.h"
+
+#include <cstring>
+#include <mutex>
+
+namespace PUERTS_NAMESPACE
+{
+#if !defined(WITH_QUICKJS)
+namespace
+{
+// 避免相近长度的占位串反复换缓冲区
+const size_t PlaceholderBufferGranularity = 64 * 1024;
+
+std::mutex PlaceholderBufferMutex;
+
+// 只弱引用，所有占位串释放后缓冲区随之释放，不会一直占着历史上最大的那块
+std::weak_ptr<const std::vector<char>> PlaceholderBuffer;
+
+std::shared_ptr<const std::vector<char>> AcquirePlaceholderBuffer(size_t Length)
+{
+    std::lock_guard<std::mutex> Lock(PlaceholderBufferMutex);
+    std::shared_ptr<const std::vector<char>> Buffer = PlaceholderBuffer.lock();
+    if (!Buffer || Buffer->size() < Length)
+    {
+        const size_t Size =
+            (Length + PlaceholderBufferGranularity - 1) / PlaceholderBufferGranularity * PlaceholderBufferGranularity;
+        Buffer = std::make_shared<const std::vector<char>>(Size, ' ');
+        PlaceholderBuffer = Buffer;
+    }
+    return Buffer;
+}
+}    // namespace
+
+v8::MaybeLocal<v8::String> FPlaceholderSourceResource::NewString(v8::Isolate* Isolate, size_t Length)
+{
+    if (Length == 0)
+    {
+        return v8::String::Empty(Isolate);
+    }
+    if (Length > static_cast<size_t>(v8::String::kMaxLength))
+    {
+        return v8::MaybeLocal<v8::String>();
+    }
+    // 失败时V8会调用Dispose释放Resource
+    return v8::String::NewExternalOneByte(Isolate, new FPlaceholderSourceResource(AcquirePlaceholderBuffer(Length), Length));
+}
+
+v8::MaybeLocal<v8::String> FExternalSourceResource::NewString(
+    v8::Isolate* Isolate, const char* Data, size_t Length, std::shared_ptr<const void> Owner)
+{
+    if (Length == 0)
+    {
+        return v8::String::Empty(Isolate);
+    }
+    if (!Owner || Length > static_cast<size_t>(v8::String::kMaxLength) || !IsAsciiSource(Data, Length))
+    {
+        return v8::String::NewFromUtf8(Isolate, Data, v8::NewStringType::kNormal, static_cast<int>(Length));
+    }
+    return v8::String::NewExternalOneByte(Isolate, new FExternalSourceResource(Data, Length, std::move(Owner)));
+}
+
+bool IsAsciiSource(const char* Data, size_t Length)
+{
+    // 按8字节一组检查最高位
+    const uint64_t HighBits = 0x8080808080808080ull;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= Length; i += sizeof(uint64_t))
+    {
+        uint64_t Word;
+        memcpy(&Word, Data + i, sizeof(Word));
+        if (Word & HighBits)
+        {
+            return false;
+        }
+    }
+    for (; i < Length; ++i)
+    {
+        if (static_cast<uint8_t>(Data[i]) & 0x80)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t GetSourceLengthFromCodeCache(const uint8_t* Data, size_t Size)
+{
+    // 头部依次为MagicNumber, VersionHash, SourceHash，SourceHash最高位标记是否为esm
+    static constexpr size_t kSourceHashOffset = 2 * sizeof(uint32_t);
+    static constexpr uint32_t kModuleFlagMask = (1u << 31);
+    if (Size < kSourceHashOffset + sizeof(uint32_t))
+    {
+        return 0;
+    }
+    uint32_t SourceHash;
+    memcpy(&SourceHash, Data + kSourceHashOffset, sizeof(SourceHash));
+    return SourceHash & ~kModuleFlagMask;
+}
+#endif
+}    // namespace PUERTS_NAMESPACE
@@ -0,0 +1,102 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#ifndef PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#define PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#define PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#endif
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+#if !defined(PUERTS_NAMESPACE)
+#if defined(WITH_QJS_NAMESPACE_SUFFIX)
+#define PUERTS_NAMESPACE puerts_qjs
+#else
+#define PUERTS_NAMESPACE puerts
+#endif
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+#if !defined(WITH_QUICKJS)
+// 消费字节码时V8只校验源码长度，这里用外部字符串提供指定长度的占位源码：
+// 所有占位串共享同一块空格缓冲区，不在js堆上分配，也不需要经过js生成
+class FPlaceholderSourceResource : public v8::String::ExternalOneByteStringResource
+{
+public:
+    static v8::MaybeLocal<v8::String> NewString(v8::Isolate* Isolate, size_t Length);
+
+    const char* data() const override
+    {
+        return Buffer->data();
+    }
+
+    size_t length() const override
+    {
+        return Length;
+    }
+
+private:
+    FPlaceholderSourceResource(std::shared_ptr<const std::vector<char>> InBuffer, size_t InLength)
+        : Buffer(std::move(InBuffer)), Length(InLength)
+    {
+    }
+
+    // 变大时换新的，旧的由仍在引用它的字符串持有到释放为止
+    std::shared_ptr<const std::vector<char>> Buffer;
+
+    size_t Length;
+};
+
+// 由外部持有的源码（如内存映射的文件），Owner保证数据在V8释放该字符串之前一直有效
+class FExternalSourceResource : public v8::String::ExternalOneByteStringResource
+{
+public:
+    // 纯ASCII的UTF-8源码不经复制直接作为外部字符串，其它的转码复制到js堆上（此时不持有Owner）
+    static v8::MaybeLocal<v8::String> NewString(
+        v8::Isolate* Isolate, const char* Data, size_t Length, std::shared_ptr<const void> Owner);
+
+    const char* data() const override
+    {
+        return Data;
+    }
+
+    size_t length() const override
+    {
+        return Length;
+    }
+
+private:
+    FExternalSourceResource(const char* InData, size_t InLength, std::shared_ptr<const void> InOwner)
+        : Data(InData), Length(InLength), Owner(std::move(InOwner))
+    {
+    }
+
+    const char* Data;
+
+    size_t Length;
+
+    std::shared_ptr<const void> Owner;
+};
+
+bool IsAsciiSource(const char* Data, size_t Length);
+
+// 从字节码头部取出编译时的源码长度
+uint32_t GetSourceLengthFromCodeCache(const uint8_t* Data, size_t Size);
+#endif
+}    // namespace PUERTS_NAMESPACE
@@ -22,6 +22,12 @@
 #include "ffi.h"
 #endif
 
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 static FuncPtr* GFuncArray = nullptr;
 static uint32_t GFuncArrayLength = 0;
 
@@ -132,6 +138,402 @@ static void FFIPrepCifVar(const v8::FunctionCallbackInfo<v8::Value>& Info)
     Info.GetReturnValue().Set(v8::Integer::New(Isolate, Status));
 }
 
+// 只有全局静态的ffi_type才能作为缓存的key，js里构造的struct类型可能被释放后地址被复用
+static bool IsBuiltinFFIType(ffi_type* Type)
+{
+    static ffi_type* BuiltinTypes[] = {&ffi_type_void, &ffi_type_uint8, &ffi_type_sint8, &ffi_type_uint16, &ffi_type_sint16,
+        &ffi_type_uint32, &ffi_type_sint32, &ffi_type_uint64, &ffi_type_sint64, &ffi_type_float, &ffi_type_double,
+        &ffi_type_pointer};
+    for (auto BuiltinType : BuiltinTypes)
+    {
+        if (BuiltinType == Type)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+struct CachedCif
+{
+    ffi_cif Cif;
+
+    std::vector<ffi_type*> ArgTypes;
+};
+
+// 签名 -> 已经prep好的cif，进程生命周期内不释放
+static std::map<std::vector<void*>, CachedCif*> GCifCache;
+
+static std::mutex GCifCacheMutex;
+
+static void FFIPrepCifCached(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+    v8::Context::Scope ContextScope(Context);
+
+    if (Info.Length() != 5 || !IsArrayBuffer(Info[2]) || !IsArrayBuffer(Info[3]))
+    {
+        PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "Bad parameters.");
+        return;
+    }
+
+    ffi_abi Abi = (ffi_abi) Info[0]->Uint32Value(Context).ToChecked();
+    int32_t FixArgs = Info[1]->Int32Value(Context).ToChecked();
+    ffi_type* RetType = reinterpret_cast<ffi_type*>(ArrayBufferData(Info[2]));
+    ffi_type** ArgTypes = reinterpret_cast<ffi_type**>(ArrayBufferData(Info[3]));
+    uint32_t Nargs = Info[4]->Uint32Value(Context).ToChecked();
+
+    if (ArrayBufferLength(Info[3]) < Nargs * sizeof(ffi_type*) || !IsBuiltinFFIType(RetType))
+    {
+        Info.GetReturnValue().SetNull();
+        return;
+    }
+
+    std::vector<void*> Key;
+    Key.reserve(Nargs + 3);
+    Key.push_back(reinterpret_cast<void*>(static_cast<intptr_t>(Abi)));
+    Key.push_back(reinterpret_cast<void*>(static_cast<intptr_t>(FixArgs)));
+    Key.push_back(RetType);
+    for (uint32_t i = 0; i < Nargs; ++i)
+    {
+        if (!IsBuiltinFFIType(ArgTypes[i]))
+        {
+            Info.GetReturnValue().SetNull();
+            return;
+        }
+        Key.push_back(ArgTypes[i]);
+    }
+
+    std::lock_guard<std::mutex> Guard(GCifCacheMutex);
+    auto Iter = GCifCache.find(Key);
+    if (Iter == GCifCache.end())
+    {
+        CachedCif* Cached = new CachedCif();
+        Cached->ArgTypes.assign(ArgTypes, ArgTypes + Nargs);
+        ffi_type** ArgTypesPtr = Cached->ArgTypes.empty() ? nullptr : Cached->ArgTypes.data();
+        ffi_status Status = FixArgs >= 0 ? ffi_prep_cif_var(&Cached->Cif, Abi, FixArgs, Nargs, RetType, ArgTypesPtr)
+                                         : ffi_prep_cif(&Cached->Cif, Abi, Nargs, RetType, ArgTypesPtr);
+        if (Status != FFI_OK)
+        {
+            delete Cached;
+            Info.GetReturnValue().SetNull();
+            return;
+        }
+        Iter = GCifCache.emplace(std::move(Key), Cached).first;
+    }
+
+    Info.GetReturnValue().Set(WrapPointer(Isolate, &Iter->second->Cif, sizeof(ffi_cif)));
+}
+
+// 常见签名（最多3个32/64位整数、指针或double参数）的预实例化调用，绕过ffi_call和参数缓冲区
+// 每个签名实例化一个参数类型完全一致的函数指针类型再调用，不通过不匹配的函数类型调用
+union FastArg
+{
+    int64_t I;
+    double D;
+};
+
+typedef void (*FastThunkFunc)(void* Func, const FastArg* Args, FastArg* Ret);
+
+template <typename T>
+FORCEINLINE T GetFastArg(const FastArg& Arg)
+{
+    return static_cast<T>(Arg.I);
+}
+
+template <>
+FORCEINLINE void* GetFastArg<void*>(const FastArg& Arg)
+{
+    return reinterpret_cast<void*>(static_cast<intptr_t>(Arg.I));
+}
+
+template <>
+FORCEINLINE double GetFastArg<double>(const FastArg& Arg)
+{
+    return Arg.D;
+}
+
+template <typename T>
+FORCEINLINE void SetFastRet(FastArg* Ret, T Value)
+{
+    Ret->I = static_cast<int64_t>(Value);
+}
+
+FORCEINLINE void SetFastRet(FastArg* Ret, void* Value)
+{
+    Ret->I = static_cast<int64_t>(reinterpret_cast<intptr_t>(Value));
+}
+
+FORCEINLINE void SetFastRet(FastArg* Ret, double Value)
+{
+    Ret->D = Value;
+}
+
+template <typename R, typename... Args>
+struct FastThunk
+{
+    template <size_t... Is>
+    static void CallImpl(void* Func, const FastArg* InArgs, FastArg* Ret, std::index_sequence<Is...>)
+    {
+        SetFastRet(Ret, reinterpret_cast<R (*)(Args...)>(Func)(GetFastArg<Args>(InArgs[Is])...));
+    }
+
+    static void Call(void* Func, const FastArg* InArgs, FastArg* Ret)
+    {
+        CallImpl(Func, InArgs, Ret, std::index_sequence_for<Args...>());
+    }
+};
+
+template <typename... Args>
+struct FastThunk<void, Args...>
+{
+    template <size_t... Is>
+    static void CallImpl(void* Func, const FastArg* InArgs, std::index_sequence<Is...>)
+    {
+        reinterpret_cast<void (*)(Args...)>(Func)(GetFastArg<Args>(InArgs[Is])...);
+    }
+
+    static void Call(void* Func, const FastArg* InArgs, FastArg* Ret)
+    {
+        CallImpl(Func, InArgs, std::index_sequence_for<Args...>());
+    }
+};
+
+// Codes中每个字符为参数的签名字符，逐个换成对应的C类型
+template <typename R, int N, typename... Args>
+struct FastThunkSelector
+{
+    static FastThunkFunc Select(const char* Codes)
+    {
+        switch (Codes[0])
+        {
+            case 'i':
+                return FastThunkSelector<R, N - 1, Args..., int32_t>::Select(Codes + 1);
+            case 'I':
+                return FastThunkSelector<R, N - 1, Args..., uint32_t>::Select(Codes + 1);
+            case 'l':
+                return FastThunkSelector<R, N - 1, Args..., int64_t>::Select(Codes + 1);
+            case 'L':
+                return FastThunkSelector<R, N - 1, Args..., uint64_t>::Select(Codes + 1);
+            case 'p':
+                return FastThunkSelector<R, N - 1, Args..., void*>::Select(Codes + 1);
+            case 'd':
+                return FastThunkSelector<R, N - 1, Args..., double>::Select(Codes + 1);
+            default:
+                return nullptr;
+        }
+    }
+};
+
+template <typename R, typename... Args>
+struct FastThunkSelector<R, 0, Args...>
+{
+    static FastThunkFunc Select(const char* Codes)
+    {
+        return &FastThunk<R, Args...>::Call;
+    }
+};
+
+template <typename R>
+static FastThunkFunc SelectFastThunkByArgs(const char* Codes, size_t Num)
+{
+    switch (Num)
+    {
+        case 0:
+            return FastThunkSelector<R, 0>::Select(Codes);
+        case 1:
+            return FastThunkSelector<R, 1>::Select(Codes);
+        case 2:
+            return FastThunkSelector<R, 2>::Select(Codes);
+        case 3:
+            return FastThunkSelector<R, 3>::Select(Codes);
+        default:
+            return nullptr;
+    }
+}
+
+static FastThunkFunc SelectFastThunk(char RetCode, const char* Codes, size_t Num)
+{
+    switch (RetCode)
+    {
+        case 'v':
+            return SelectFastThunkByArgs<void>(Codes, Num);
+        case 'i':
+            return SelectFastThunkByArgs<int32_t>(Codes, Num);
+        case 'I':
+            return SelectFastThunkByArgs<uint32_t>(Codes, Num);
+        case 'l':
+            return SelectFastThunkByArgs<int64_t>(Codes, Num);
+        case 'L':
+            return SelectFastThunkByArgs<uint64_t>(Codes, Num);
+        case 'p':
+            return SelectFastThunkByArgs<void*>(Codes, Num);
+        case 'd':
+            return SelectFastThunkByArgs<double>(Codes, Num);
+        default:
+            return nullptr;
+    }
+}
+
+static const size_t MaxFastArgs = 3;
+
+struct FastThunkInfo
+{
+    FastThunkFunc Thunk;
+
+    // 签名字符：v void, i/I int32/uint32, l/L int64/uint64, p pointer, d double，
+    // 8/16位整数等其它签名走通用的ffi_call
+    char RetCode;
+
+    char ArgCodes[MaxFastArgs];
+
+    size_t ArgNum;
+};
+
+static std::map<std::string, FastThunkInfo*> GFastThunks;
+
+static std::mutex GFastThunksMutex;
+
+static void FFIGetFastThunk(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+
+    if (Info.Length() != 1 || !Info[0]->IsString())
+    {
+        PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "ffi_get_fast_thunk: signature string expected");
+        return;
+    }
+
+    std::string Signature = *v8::String::Utf8Value(Isolate, Info[0]);
+    if (Signature.empty() || Signature.size() - 1 > MaxFastArgs)
+    {
+        Info.GetReturnValue().SetNull();
+        return;
+    }
+
+    std::lock_guard<std::mutex> Guard(GFastThunksMutex);
+    auto Iter = GFastThunks.find(Signature);
+    if (Iter == GFastThunks.end())
+    {
+        FastThunkInfo* ThunkInfo = nullptr;
+        char RetCode = Signature[0];
+        size_t ArgNum = Signature.size() - 1;
+        FastThunkFunc Thunk = SelectFastThunk(RetCode, Signature.c_str() + 1, ArgNum);
+        if (Thunk)
+        {
+            ThunkInfo = new FastThunkInfo();
+            ThunkInfo->Thunk = Thunk;
+            ThunkInfo->RetCode = RetCode;
+            ThunkInfo->ArgNum = ArgNum;
+            for (size_t i = 0; i < ArgNum; ++i)
+            {
+                ThunkInfo->ArgCodes[i] = Signature[i + 1];
+            }
+        }
+        // 不支持的签名也记录下来，避免重复解析
+        Iter = GFastThunks.emplace(Signature, ThunkInfo).first;
+    }
+
+    if (Iter->second)
+    {
+        Info.GetReturnValue().Set(WrapPointer(Isolate, Iter->second, sizeof(FastThunkInfo)));
+    }
+    else
+    {
+        Info.GetReturnValue().SetNull();
+    }
+}
+
+static v8::Local<v8::Value> FastRetToValue(v8::Isolate* Isolate, char RetCode, const FastArg& Ret)
+{
+    switch (RetCode)
+    {
+        case 'i':
+            return v8::Integer::New(Isolate, static_cast<int32_t>(Ret.I));
+        case 'I':
+            return v8::Integer::NewFromUnsigned(Isolate, static_cast<uint32_t>(Ret.I));
+        case 'l':
+            return v8::BigInt::New(Isolate, static_cast<int64_t>(Ret.I));
+        case 'L':
+            return v8::BigInt::NewFromUnsigned(Isolate, static_cast<uint64_t>(Ret.I));
+        case 'p':
+            return WrapPointer(Isolate, reinterpret_cast<void*>(static_cast<intptr_t>(Ret.I)));
+        case 'd':
+            return v8::Number::New(Isolate, Ret.D);
+        default:
+            return v8::Undefined(Isolate);
+    }
+}
+
+static void FFICallFast(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    if (Info.Length() < 2 || ArrayBufferLength(Info[0]) != sizeof(FastThunkInfo))
+    {
+        PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "ffi_call_fast(): invalid thunk");
+        return;
+    }
+
+    FastThunkInfo* ThunkInfo = reinterpret_cast<FastThunkInfo*>(ArrayBufferData(Info[0]));
+    if (static_cast<size_t>(Info.Length()) != ThunkInfo->ArgNum + 2)
+    {
+        PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "ffi_call_fast(): argument count not match");
+        return;
+    }
+
+    void* Func;
+    if (Info[1]->IsNumber())
+    {
+        uint32_t Index = Info[1]->Uint32Value(Context).ToChecked();
+        if (Index >= GFuncArrayLength)
+        {
+            PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "ffi_call_fast(): function index out of range!");
+            return;
+        }
+        Func = reinterpret_cast<void*>(GFuncArray[Index]);
+    }
+    else
+    {
+        Func = ArrayBufferData(Info[1]);
+    }
+
+    FastArg Args[MaxFastArgs];
+    for (size_t i = 0; i < ThunkInfo->ArgNum; ++i)
+    {
+        auto Arg = Info[static_cast<int>(i) + 2];
+        switch (ThunkInfo->ArgCodes[i])
+        {
+            case 'd':
+                Args[i].D = Arg->IsNumber() ? Arg.As<v8::Number>()->Value() : 0;
+                break;
+            case 'p':
+                Args[i].I = static_cast<int64_t>(reinterpret_cast<intptr_t>(Arg->IsNull() ? nullptr : ArrayBufferData(Arg)));
+                break;
+            case 'l':
+            case 'L':
+                Args[i].I = Arg->IsBigInt() ? Arg.As<v8::BigInt>()->Int64Value() : GetInt64(Arg);
+                break;
+            default:
+                Args[i].I = GetInt64(Arg);
+                break;
+        }
+    }
+
+    FastArg Ret;
+    Ret.I = 0;
+    ThunkInfo->Thunk(Func, Args, &Ret);
+
+    Info.GetReturnValue().Set(FastRetToValue(Isolate, ThunkInfo->RetCode, Ret));
+}
+
 class ClosureInfo
 {
 public:
@@ -460,6 +862,21 @@ static void Init(v8::Local<v8::Context> Context, v8::Local<v8::Object> Exports)
             v8::FunctionTemplate::New(Isolate, FFICall)->GetFunction(Context).ToLocalChecked())
         .Check();
 
+    Exports
+        ->Set(Context, PUERTS_NAMESPACE::FV8Utils::ToV8String(Isolate, "ffi_prep_cif_cached"),
+            v8::FunctionTemplate::New(Isolate, FFIPrepCifCached)->GetFunction(Context).ToLocalChecked())
+        .Check();
+
+    Exports
+        ->Set(Context, PUERTS_NAMESPACE::FV8Utils::ToV8String(Isolate, "ffi_get_fast_thunk"),
+            v8::FunctionTemplate::New(Isolate, FFIGetFastThunk)->GetFunction(Context).ToLocalChecked())
+        .Check();
+
+    Exports
+        ->Set(Context, PUERTS_NAMESPACE::FV8Utils::ToV8String(Isolate, "ffi_call_fast"),
+            v8::FunctionTemplate::New(Isolate, FFICallFast)->GetFunction(Context).ToLocalChecked())
+        .Check();
+
     Exports
         ->Set(Context, PUERTS_NAMESPACE::FV8Utils::ToV8String(Isolate, "writePointer"),
             v8::FunctionTemplate::New(Isolate, WritePointer)->GetFunction(Context).ToLocalChecked())
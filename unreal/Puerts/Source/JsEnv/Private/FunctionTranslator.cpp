@@ -8,6 +8,7 @@
 
 #include "FunctionTranslator.h"
 #include "V8Utils.h"
+#include "BindingProfiler.h"
 #include "Misc/DefaultValueHelper.h"
 #include <mutex>
 
@@ -219,15 +220,26 @@ v8::Local<v8::FunctionTemplate> FFunctionTranslator::ToFunctionTemplate(v8::Isol
 void FFunctionTranslator::Call(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
     FFunctionTranslator* This = static_cast<FFunctionTranslator*>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
     This->Call(Isolate, Context, Info);
 }
 
+const char* FFunctionTranslator::GetProfileName(const void* Key)
+{
+    thread_local std::string Name;
+    auto Translator = static_cast<const FFunctionTranslator*>(Key);
+    UFunction* Func = Translator->Function.Get();
+    Name = Func ? TCHAR_TO_UTF8(*FString::Printf(TEXT("%s.%s"), *Func->GetOuter()->GetName(), *Func->GetName())) : "<invalid>";
+    return Name.c_str();
+}
+
 void FFunctionTranslator::Call(
     v8::Isolate* Isolate, v8::Local<v8::Context>& Context, const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
+    FBindingCallScope ProfileScope(this, &FFunctionTranslator::GetProfileName);
     UObject* CallObject = IsStatic ? BindObject.Get() : FV8Utils::GetUObject(Info.Holder());
     if (!CallObject)
     {
@@ -287,7 +299,9 @@ void FFunctionTranslator::SlowCall(v8::Isolate* Isolate, v8::Local<v8::Context>&
         return;
     }
 
+    FBindingCallScope::BeginTargetCall();
     CallObject->UObject::ProcessEvent(CallFunction, Params);
+    FBindingCallScope::EndTargetCall();
 
     Call_ProcessReturnAndOutParams(Isolate, Context, Info, Params, 0);
 }
@@ -383,7 +397,9 @@ void FFunctionTranslator::FastCall(v8::Isolate* Isolate, v8::Local<v8::Context>&
 
     const bool bHasReturnParam = CallFunction->ReturnValueOffset != MAX_uint16;
     uint8* ReturnValueAddress = bHasReturnParam ? ((uint8*) Params + CallFunction->ReturnValueOffset) : nullptr;
+    FBindingCallScope::BeginTargetCall();
     CallFunction->Invoke(CallObject, NewStack, ReturnValueAddress);
+    FBindingCallScope::EndTargetCall();
 
     if (Return)
     {
@@ -651,6 +667,7 @@ v8::Local<v8::FunctionTemplate> FExtensionMethodTranslator::ToFunctionTemplate(v
 void FExtensionMethodTranslator::CallExtension(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
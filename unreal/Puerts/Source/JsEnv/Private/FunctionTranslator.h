@@ -15,6 +15,7 @@
 #include "CoreMinimal.h"
 #include "CoreUObject.h"
 #include "PropertyTranslator.h"
+#include "BindingProfiler.h"
 
 #include "NamespaceDef.h"
 
@@ -34,6 +35,7 @@ public:
 
     virtual ~FFunctionTranslator()
     {
+        FBindingProfiler::NotifyKeyReleased(this);
         if (ArgumentDefaultValues)
         {
             FMemory::Free(ArgumentDefaultValues);
@@ -130,6 +132,9 @@ private:
 
     void Init(UFunction* InFunction, bool IsDelegate);
 
+    // 供FBindingProfiler首次记录时取名字
+    static const char* GetProfileName(const void* Key);
+
     friend class FStructWrapper;
     friend class FJsEnvImpl;
 };
@@ -0,0 +1,104 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "HeapLimitGuard.h"
+
+#include <cstdio>
+
+namespace PUERTS_NAMESPACE
+{
+// 回收后低于初始上限的这个比例时，V8自动恢复初始上限
+static const double RestoreHeapLimitThreshold = 0.5;
+
+FHeapLimitGuard::FHeapLimitGuard(v8::Isolate* InIsolate, size_t InHeadroomInBytes)
+    : Isolate(InIsolate), HeadroomInBytes(InHeadroomInBytes)
+{
+#if !defined(WITH_QUICKJS)
+    Isolate->AddNearHeapLimitCallback(&FHeapLimitGuard::NearHeapLimitCallback, this);
+    Isolate->AutomaticallyRestoreInitialHeapLimit(RestoreHeapLimitThreshold);
+#endif
+}
+
+FHeapLimitGuard::~FHeapLimitGuard()
+{
+#if !defined(WITH_QUICKJS)
+    Isolate->RemoveNearHeapLimitCallback(&FHeapLimitGuard::NearHeapLimitCallback, 0);
+#endif
+}
+
+#if !defined(WITH_QUICKJS)
+void FHeapLimitGuard::ApplyHeapBudget(
+    v8::ResourceConstraints& Constraints, size_t MaxOldGenerationSizeInBytes, size_t MaxYoungGenerationSizeInBytes)
+{
+    if (MaxOldGenerationSizeInBytes > 0)
+    {
+        Constraints.set_max_old_generation_size_in_bytes(MaxOldGenerationSizeInBytes);
+    }
+    if (MaxYoungGenerationSizeInBytes > 0)
+    {
+        Constraints.set_max_young_generation_size_in_bytes(MaxYoungGenerationSizeInBytes);
+    }
+}
+
+size_t FHeapLimitGuard::NearHeapLimitCallback(void* Data, size_t CurrentHeapLimit, size_t InitialHeapLimit)
+{
+    // 处于GC中，不能执行js也不能在js堆上分配，这里只记录并终止当前执行
+    auto Self = static_cast<FHeapLimitGuard*>(Data);
+    ++Self->HitCount;
+    Self->Pending = true;
+    Self->HeapLimitAtHit = CurrentHeapLimit;
+    Self->InitialHeapLimit = InitialHeapLimit;
+    v8::HeapStatistics Statistics;
+    Self->Isolate->GetHeapStatistics(&Statistics);
+    Self->UsedHeapAtHit = Statistics.used_heap_size();
+
+    // 每次都要放宽，否则V8会直接按OOM中止进程
+    // 终止后脚本持有的对象不可达，安全点回收后上限会自动恢复
+    Self->Isolate->TerminateExecution();
+    return CurrentHeapLimit + Self->HeadroomInBytes;
+}
+#endif
+
+bool FHeapLimitGuard::ProcessPending(std::string& OutReport)
+{
+    if (!Pending)
+    {
+        return false;
+    }
+    Pending = false;
+
+#if !defined(WITH_QUICKJS)
+    // 没有js在栈上时终止标记已无意义，留着会误杀下一次调用
+    if (Isolate->IsExecutionTerminating())
+    {
+        Isolate->CancelTerminateExecution();
+    }
+#endif
+
+    if (CleanupCallback)
+    {
+        CleanupCallback();
+    }
+    Isolate->LowMemoryNotification();
+
+    size_t UsedHeapAfterCleanup = 0;
+#if !defined(WITH_QUICKJS)
+    v8::HeapStatistics Statistics;
+    Isolate->GetHeapStatistics(&Statistics);
+    UsedHeapAfterCleanup = Statistics.used_heap_size();
+#endif
+    char Buf[256];
+    snprintf(Buf, sizeof(Buf),
+        "js heap near limit (hit %u): used %.1f MB, limit %.1f MB (initial %.1f MB), %.1f MB after cleanup, "
+        "current execution terminated",
+        HitCount, UsedHeapAtHit / 1048576.0, HeapLimitAtHit / 1048576.0, InitialHeapLimit / 1048576.0,
+        UsedHeapAfterCleanup / 1048576.0);
+    OutReport = Buf;
+    return true;
+}
+}    // namespace PUERTS_NAMESPACE
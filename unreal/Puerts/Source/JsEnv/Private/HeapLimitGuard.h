@@ -0,0 +1,89 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+#ifndef PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#define PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#define PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#endif
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+#if !defined(PUERTS_NAMESPACE)
+#if defined(WITH_QJS_NAMESPACE_SUFFIX)
+#define PUERTS_NAMESPACE puerts_qjs
+#else
+#define PUERTS_NAMESPACE puerts
+#endif
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+// 堆接近上限时不让进程直接OOM崩溃：临时放宽上限让当前分配完成，终止正在执行的脚本，
+// 再在宿主的安全点（没有js在栈上时）做应急清理并输出诊断信息
+// 必须在Isolate所在线程使用，且生命周期不能超过Isolate
+class FHeapLimitGuard
+{
+public:
+    // InHeadroomInBytes为每次触及上限时临时放宽的额度
+    FHeapLimitGuard(v8::Isolate* InIsolate, size_t InHeadroomInBytes = 16 * 1024 * 1024);
+
+    ~FHeapLimitGuard();
+
+    // 应急清理时最先调用，用于释放宿主持有的js对象和缓存
+    void SetCleanupCallback(std::function<void()> InCleanupCallback)
+    {
+        CleanupCallback = std::move(InCleanupCallback);
+    }
+
+    // 在宿主安全点调用，有待处理的上限事件时执行清理（宿主回调、完整GC）并返回true
+    // OutReport为诊断信息
+    bool ProcessPending(std::string& OutReport);
+
+    uint32_t GetHitCount() const
+    {
+        return HitCount;
+    }
+
+#if !defined(WITH_QUICKJS)
+    // 单位为字节，为0的项保持V8默认值
+    static void ApplyHeapBudget(v8::ResourceConstraints& Constraints, size_t MaxOldGenerationSizeInBytes,
+        size_t MaxYoungGenerationSizeInBytes);
+#endif
+
+private:
+#if !defined(WITH_QUICKJS)
+    static size_t NearHeapLimitCallback(void* Data, size_t CurrentHeapLimit, size_t InitialHeapLimit);
+#endif
+
+    v8::Isolate* Isolate;
+
+    size_t HeadroomInBytes;
+
+    std::function<void()> CleanupCallback;
+
+    bool Pending = false;
+
+    uint32_t HitCount = 0;
+
+    size_t UsedHeapAtHit = 0;
+
+    size_t HeapLimitAtHit = 0;
+
+    size_t InitialHeapLimit = 0;
+};
+}    // namespace PUERTS_NAMESPACE
@@ -0,0 +1,189 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "IdleGCScheduler.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace PUERTS_NAMESPACE
+{
+namespace
+{
+double NowSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void AppendHistogramJson(std::string& Out, const char* Name, const FGCPauseHistogram& Histogram)
+{
+    char Buf[160];
+    snprintf(Buf, sizeof(Buf), "\"%s\": {\"count\": %llu, \"major\": %llu, \"total_ms\": %.3f, \"max_ms\": %.3f, \"buckets\": [",
+        Name, static_cast<unsigned long long>(Histogram.Count), static_cast<unsigned long long>(Histogram.MajorCount),
+        Histogram.TotalMs, Histogram.MaxMs);
+    Out += Buf;
+    for (int i = 0; i < FGCPauseHistogram::BucketCount; ++i)
+    {
+        if (i > 0)
+        {
+            Out += ", ";
+        }
+        Out += std::to_string(Histogram.Buckets[i]);
+    }
+    Out += "]}";
+}
+}    // namespace
+
+void FGCPauseHistogram::Add(double Ms, bool IsMajor)
+{
+    int Bucket = 0;
+    double Upper = 0.5;
+    while (Bucket < BucketCount - 1 && Ms >= Upper)
+    {
+        ++Bucket;
+        Upper *= 2;
+    }
+    ++Buckets[Bucket];
+    ++Count;
+    if (IsMajor)
+    {
+        ++MajorCount;
+    }
+    TotalMs += Ms;
+    if (Ms > MaxMs)
+    {
+        MaxMs = Ms;
+    }
+}
+
+FIdleGCScheduler::FIdleGCScheduler(v8::Isolate* InIsolate, v8::Platform* InPlatform) : Isolate(InIsolate), Platform(InPlatform)
+{
+#if !defined(WITH_QUICKJS)
+    Isolate->AddGCPrologueCallback(&FIdleGCScheduler::OnGCPrologue, this);
+    Isolate->AddGCEpilogueCallback(&FIdleGCScheduler::OnGCEpilogue, this);
+#endif
+    HeapSizeAfterMajorGC = GetUsedHeapSize();
+    LastCompactTime = LastFullGCTime = NowSeconds();
+}
+
+FIdleGCScheduler::~FIdleGCScheduler()
+{
+#if !defined(WITH_QUICKJS)
+    Isolate->RemoveGCPrologueCallback(&FIdleGCScheduler::OnGCPrologue, this);
+    Isolate->RemoveGCEpilogueCallback(&FIdleGCScheduler::OnGCEpilogue, this);
+#endif
+}
+
+size_t FIdleGCScheduler::GetUsedHeapSize()
+{
+#if !defined(WITH_QUICKJS)
+    v8::HeapStatistics Statistics;
+    Isolate->GetHeapStatistics(&Statistics);
+    return Statistics.used_heap_size();
+#else
+    return 0;
+#endif
+}
+
+bool FIdleGCScheduler::OnFrameIdle(double IdleBudgetInSeconds)
+{
+    if (IdleBudgetInSeconds < MinIdleBudgetInSeconds)
+    {
+        return false;
+    }
+
+    const double Start = NowSeconds();
+    bool DidWork = false;
+    InIdle = true;
+
+    if (CompactCallback && Start - LastCompactTime >= CompactIntervalInSeconds)
+    {
+        CompactCallback();
+        LastCompactTime = Start;
+        DidWork = true;
+    }
+
+    const double Remaining = IdleBudgetInSeconds - (NowSeconds() - Start);
+#if !defined(WITH_QUICKJS)
+    const size_t UsedHeapSize = GetUsedHeapSize();
+    const bool HeapGrown = UsedHeapSize > HeapSizeAfterMajorGC + FullGCHeapGrowthBytes;
+#else
+    // QuickJS拿不到堆大小，按时间间隔做循环引用回收
+    const bool HeapGrown = Start - LastFullGCTime >= CompactIntervalInSeconds;
+#endif
+    if (Remaining >= FullGCIdleBudgetInSeconds && HeapGrown)
+    {
+        Isolate->LowMemoryNotification();
+        LastFullGCTime = NowSeconds();
+        DidWork = true;
+    }
+#if !defined(WITH_QUICKJS) && V8_MAJOR_VERSION < 12
+    else if (Remaining > 0)
+    {
+        // 有新的分配才需要再次通知
+        if (IdleWorkDone && UsedHeapSize > HeapSizeAtIdleWorkDone)
+        {
+            IdleWorkDone = false;
+        }
+        if (!IdleWorkDone)
+        {
+            // 由V8在截止时间内推进增量标记，标记完成时顺带做完整GC
+            IdleWorkDone = Isolate->IdleNotificationDeadline(Platform->MonotonicallyIncreasingTime() + Remaining);
+            HeapSizeAtIdleWorkDone = GetUsedHeapSize();
+            DidWork = true;
+        }
+    }
+#endif
+
+    InIdle = false;
+    return DidWork;
+}
+
+void FIdleGCScheduler::ResetStats()
+{
+    FramePauses = FGCPauseHistogram();
+    IdlePauses = FGCPauseHistogram();
+}
+
+std::string FIdleGCScheduler::GetPauseReport() const
+{
+    std::string Out = "{";
+    AppendHistogramJson(Out, "frame", FramePauses);
+    Out += ", ";
+    AppendHistogramJson(Out, "idle", IdlePauses);
+    Out += "}";
+    return Out;
+}
+
+#if !defined(WITH_QUICKJS)
+void FIdleGCScheduler::OnGCPrologue(v8::Isolate* Isolate, v8::GCType Type, v8::GCCallbackFlags Flags, void* Data)
+{
+    auto Self = static_cast<FIdleGCScheduler*>(Data);
+    if (Self->GCDepth++ == 0)
+    {
+        Self->GCStartTime = NowSeconds();
+    }
+}
+
+void FIdleGCScheduler::OnGCEpilogue(v8::Isolate* Isolate, v8::GCType Type, v8::GCCallbackFlags Flags, void* Data)
+{
+    auto Self = static_cast<FIdleGCScheduler*>(Data);
+    if (Self->GCDepth == 0 || --Self->GCDepth > 0)
+    {
+        return;
+    }
+    const double Ms = (NowSeconds() - Self->GCStartTime) * 1000;
+    const bool IsMajor = (Type & v8::kGCTypeMarkSweepCompact) != 0;
+    (Self->InIdle ? Self->IdlePauses : Self->FramePauses).Add(Ms, IsMajor);
+    if (IsMajor)
+    {
+        Self->HeapSizeAfterMajorGC = Self->GetUsedHeapSize();
+    }
+}
+#endif
+}    // namespace PUERTS_NAMESPACE
@@ -0,0 +1,129 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+#ifndef PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#define PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#define PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#endif
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+#if !defined(PUERTS_NAMESPACE)
+#if defined(WITH_QJS_NAMESPACE_SUFFIX)
+#define PUERTS_NAMESPACE puerts_qjs
+#else
+#define PUERTS_NAMESPACE puerts
+#endif
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+// GC停顿时长分布，桶上界依次为0.5, 1, 2, 4, 8, 16, 32毫秒，最后一个桶放更长的停顿
+struct FGCPauseHistogram
+{
+    static constexpr int BucketCount = 8;
+
+    uint64_t Buckets[BucketCount] = {};
+    uint64_t Count = 0;
+    uint64_t MajorCount = 0;
+    double TotalMs = 0;
+    double MaxMs = 0;
+
+    void Add(double Ms, bool IsMajor);
+};
+
+// 把GC尽量挪到宿主每帧剩余的空闲时间里做，并按是否发生在空闲时间统计停顿分布
+// 必须在Isolate所在线程使用，且生命周期不能超过Isolate
+class FIdleGCScheduler
+{
+public:
+    FIdleGCScheduler(v8::Isolate* InIsolate, v8::Platform* InPlatform);
+
+    ~FIdleGCScheduler();
+
+    // 宿主在帧末尾调用，IdleBudgetInSeconds为本帧剩余可用时间，返回是否做了GC相关的工作
+    bool OnFrameIdle(double IdleBudgetInSeconds);
+
+    // 包装对象映射表的整理，在空闲时间里限频调用
+    void SetCompactCallback(std::function<void()> InCompactCallback)
+    {
+        CompactCallback = std::move(InCompactCallback);
+    }
+
+    // 低于该值的空闲时间直接忽略
+    double MinIdleBudgetInSeconds = 0.001;
+
+    // 空闲时间足够长（如加载界面）且堆增长超过FullGCHeapGrowthBytes时直接做一次完整GC
+    double FullGCIdleBudgetInSeconds = 0.05;
+
+    size_t FullGCHeapGrowthBytes = 16 * 1024 * 1024;
+
+    double CompactIntervalInSeconds = 5.0;
+
+    // 发生在帧内（非空闲时间）的停顿
+    const FGCPauseHistogram& GetFramePauses() const
+    {
+        return FramePauses;
+    }
+
+    const FGCPauseHistogram& GetIdlePauses() const
+    {
+        return IdlePauses;
+    }
+
+    void ResetStats();
+
+    std::string GetPauseReport() const;
+
+private:
+#if !defined(WITH_QUICKJS)
+    static void OnGCPrologue(v8::Isolate* Isolate, v8::GCType Type, v8::GCCallbackFlags Flags, void* Data);
+
+    static void OnGCEpilogue(v8::Isolate* Isolate, v8::GCType Type, v8::GCCallbackFlags Flags, void* Data);
+#endif
+
+    size_t GetUsedHeapSize();
+
+    v8::Isolate* Isolate;
+
+    v8::Platform* Platform;
+
+    std::function<void()> CompactCallback;
+
+    bool InIdle = false;
+
+    // V8返回true表示在有新的工作之前不需要再通知空闲
+    bool IdleWorkDone = false;
+
+    size_t HeapSizeAtIdleWorkDone = 0;
+
+    size_t HeapSizeAfterMajorGC = 0;
+
+    double LastCompactTime = 0;
+
+    double LastFullGCTime = 0;
+
+    int GCDepth = 0;
+
+    double GCStartTime = 0;
+
+    FGCPauseHistogram FramePauses;
+
+    FGCPauseHistogram IdlePauses;
+};
+}    // namespace PUERTS_NAMESPACE
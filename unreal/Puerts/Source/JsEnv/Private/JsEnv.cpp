@@ -8,6 +8,7 @@
 
 #include "JsEnv.h"
 #include "JsEnvImpl.h"
+#include "BindingProfiler.h"
 
 namespace PUERTS_NAMESPACE
 {
@@ -54,6 +55,41 @@ void FJsEnv::WaitDebugger(double timeout)
     GameScript->WaitDebugger(timeout);
 }
 
+bool FJsEnv::OnFrameIdle(double IdleBudgetInSeconds)
+{
+    return GameScript->OnFrameIdle(IdleBudgetInSeconds);
+}
+
+FString FJsEnv::GetGCPauseReport()
+{
+    return GameScript->GetGCPauseReport();
+}
+
+bool FJsEnv::StartCpuProfiling(const FString& Title, int32 SamplingIntervalUs)
+{
+    return GameScript->StartCpuProfiling(Title, SamplingIntervalUs);
+}
+
+bool FJsEnv::StopCpuProfiling(const FString& Title, const FString& OutputPath)
+{
+    return GameScript->StopCpuProfiling(Title, OutputPath);
+}
+
+void FJsEnv::SetBindingProfilerEnabled(bool Enabled)
+{
+    FBindingProfiler::SetEnabled(Enabled);
+}
+
+FString FJsEnv::GetBindingProfileReport(int32 MaxEntries)
+{
+    return UTF8_TO_TCHAR(FBindingProfiler::ToJson(static_cast<size_t>(FMath::Max(MaxEntries, 0))).c_str());
+}
+
+void FJsEnv::ResetBindingProfiler()
+{
+    FBindingProfiler::Reset();
+}
+
 #if !defined(ENGINE_INDEPENDENT_JSENV)
 void FJsEnv::TryBindJs(const class UObjectBase* InObject)
 {
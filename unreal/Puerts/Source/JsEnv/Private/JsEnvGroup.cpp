@@ -12,6 +12,11 @@
 #include "TsDynamicInvoker.h"
 #include "DynamicInvoker.h"
 #include "PuertsNamespaceDef.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
 
 namespace PUERTS_NAMESPACE
 {
@@ -92,6 +97,97 @@ public:
     }
 };
 
+class FJsEnvWorker : public FRunnable
+{
+public:
+    FJsEnvWorker(FJsEnvImpl* InJsEnv, int Index) : JsEnv(InJsEnv)
+    {
+        WakeUpEvent = FPlatformProcess::GetSynchEventFromPool(false);
+        Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("PuertsJsEnvWorker%d"), Index));
+    }
+
+    virtual ~FJsEnvWorker() override
+    {
+        RequestStop();
+        Join();
+        FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+    }
+
+    // 只通知退出，不等待，方便先通知所有线程再统一Join
+    void RequestStop()
+    {
+        Stopping = true;
+        WakeUpEvent->Trigger();
+    }
+
+    void Join()
+    {
+        if (Thread)
+        {
+            Thread->WaitForCompletion();
+            delete Thread;
+            Thread = nullptr;
+        }
+    }
+
+    virtual uint32 Run() override
+    {
+        // 该线程上运行的脚本访问UObject/UFunction时会抛js异常，这些只能在游戏线程上访问
+        FV8Utils::SetWorkerThread(true);
+        while (!Stopping)
+        {
+            WakeUpEvent->Wait();
+            if (Stopping)
+            {
+                break;
+            }
+#if !defined(WITH_QUICKJS)
+            JsEnv->DispatchGroupMessages(0);
+#endif
+        }
+        return 0;
+    }
+
+    FORCEINLINE bool IsRunning() const
+    {
+        return Thread != nullptr;
+    }
+
+    // 自动重置事件，处理期间到达的消息会让下一轮Wait立即返回，不会丢失
+    FORCEINLINE void WakeUp()
+    {
+        WakeUpEvent->Trigger();
+    }
+
+private:
+    FJsEnvImpl* JsEnv;
+
+    FEvent* WakeUpEvent = nullptr;
+
+    FRunnableThread* Thread = nullptr;
+
+    std::atomic<bool> Stopping{false};
+};
+
+#if !defined(WITH_QUICKJS)
+static bool RouteGroupMessage(const std::vector<std::shared_ptr<IJsEnv>>& JsEnvList,
+    const std::vector<std::unique_ptr<FJsEnvWorker>>& Workers, const std::atomic<bool>& WorkersStarted, FRWLock& RouteLock,
+    const bool& RouteClosed, int Target, FJsEnvImpl::FGroupMessage&& Message)
+{
+    FRWScopeLock ScopeLock(RouteLock, SLT_ReadOnly);
+    if (RouteClosed || Target < 0 || Target >= JsEnvList.size())
+    {
+        return false;
+    }
+    static_cast<FJsEnvImpl*>(JsEnvList[Target].get())->EnqueueGroupMessage(MoveTemp(Message));
+    if (WorkersStarted.load(std::memory_order_acquire))
+    {
+        Workers[Target]->WakeUp();
+    }
+    return true;
+}
+#endif
+
 FJsEnvGroup::FJsEnvGroup(int Size, const FString& ScriptRoot)
 {
     check(Size > 1);
@@ -128,14 +224,104 @@ void FJsEnvGroup::Init()
     {
         JsEnvs[i]->TsDynamicInvoker = GroupDynamicInvoker;
         JsEnvs[i]->MixinInvoker = GroupDynamicInvoker;
+#if !defined(WITH_QUICKJS)
+        JsEnvs[i]->InitGroupMessaging(i,
+            [this](int32 Target, FJsEnvImpl::FGroupMessage&& Message)
+            {
+                return RouteGroupMessage(
+                    JsEnvList, Workers, WorkersStarted, RouteLock, RouteClosed, Target, MoveTemp(Message));
+            });
+#endif
     }
+    Workers.resize(JsEnvs.size());
 }
 
 FJsEnvGroup::~FJsEnvGroup()
 {
+    // 先关闭路由：此后工作线程上的postMessage直接返回false，不会再唤醒正在析构的worker
+    {
+        FRWScopeLock ScopeLock(RouteLock, SLT_Write);
+        RouteClosed = true;
+    }
+    // 通知所有线程退出并全部Join之后才销毁，避免逐个析构时其它线程还在运行
+    for (auto& Worker : Workers)
+    {
+        if (Worker)
+        {
+            Worker->RequestStop();
+        }
+    }
+    for (auto& Worker : Workers)
+    {
+        if (Worker)
+        {
+            Worker->Join();
+        }
+    }
+    WorkersStarted = false;
+    Workers.clear();
+    // 虚拟机可能被外部持有，需断开对本对象的引用，此时已没有工作线程在读取router
+#if !defined(WITH_QUICKJS)
+    for (int i = 0; i < JsEnvList.size(); i++)
+    {
+        static_cast<FJsEnvImpl*>(JsEnvList[i].get())->InitGroupMessaging(-1, nullptr);
+    }
+#endif
     JsEnvList.clear();
 }
 
+bool FJsEnvGroup::StartWorkerThreads()
+{
+#if defined(THREAD_SAFE) && !defined(WITH_QUICKJS)
+    if (WorkersStarted)
+    {
+        return true;
+    }
+    if (!FPlatformProcess::SupportsMultithreading())
+    {
+        return false;
+    }
+    for (int i = 0; i < JsEnvList.size(); i++)
+    {
+        auto JsEnv = static_cast<FJsEnvImpl*>(JsEnvList[i].get());
+        Workers[i] = std::make_unique<FJsEnvWorker>(JsEnv, i);
+        if (!Workers[i]->IsRunning())
+        {
+            Workers.clear();
+            Workers.resize(JsEnvList.size());
+            return false;
+        }
+    }
+    for (int i = 0; i < JsEnvList.size(); i++)
+    {
+        // ticker也在游戏线程，停掉后只由工作线程消费该虚拟机的消息
+        static_cast<FJsEnvImpl*>(JsEnvList[i].get())->SetGroupMessageDispatchOnTicker(false);
+    }
+    WorkersStarted.store(true, std::memory_order_release);
+    for (int i = 0; i < Workers.size(); i++)
+    {
+        // 切换前已经入队的消息
+        Workers[i]->WakeUp();
+    }
+    return true;
+#else
+    // 非THREAD_SAFE时虚拟机没有加锁，不能在多个线程上使用
+    return false;
+#endif
+}
+
+bool FJsEnvGroup::PostGroupMessage(int Index, const FString& Message)
+{
+#if !defined(WITH_QUICKJS)
+    FJsEnvImpl::FGroupMessage GroupMessage;
+    GroupMessage.Sender = -1;
+    GroupMessage.Text = Message;
+    return RouteGroupMessage(JsEnvList, Workers, WorkersStarted, RouteLock, RouteClosed, Index, MoveTemp(GroupMessage));
+#else
+    return false;
+#endif
+}
+
 void FJsEnvGroup::TryBindJs(const class UObjectBase* InObject)
 {
     for (int i = 0; i < JsEnvList.size(); i++)
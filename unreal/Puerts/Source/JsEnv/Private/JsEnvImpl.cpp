@@ -11,6 +11,8 @@
 #include "DynamicDelegateProxy.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Async/MappedFileHandle.h"
 #include "StructWrapper.h"
 #include "DelegateWrapper.h"
 #include "ContainerWrapper.h"
@@ -33,6 +35,7 @@
 #include "ContainerMeta.h"
 
 #include "V8InspectorImpl.h"
+#include "ExternalSourceResource.h"
 #if USE_WASM3
 #include "WasmModuleInstance.h"
 #endif
@@ -356,7 +359,14 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
             if (Flag.StartsWith(Max_Old_Space_Size_Name))
             {
                 size_t Val = FCString::Atoi(*Flag.Mid(Max_Old_Space_Size_Name.Len()));
-                CreateParams.constraints.set_max_old_generation_size_in_bytes(Val * 1024 * 1024);
+                FHeapLimitGuard::ApplyHeapBudget(CreateParams.constraints, Val * 1024 * 1024, 0);
+            }
+            static FString Max_Semi_Space_Size_Name(TEXT("--max-semi-space-size="));
+            if (Flag.StartsWith(Max_Semi_Space_Size_Name))
+            {
+                // 新生代由两个semi space和一个同样大小的old-to-new区组成
+                size_t Val = FCString::Atoi(*Flag.Mid(Max_Semi_Space_Size_Name.Len()));
+                FHeapLimitGuard::ApplyHeapBudget(CreateParams.constraints, 0, Val * 3 * 1024 * 1024);
             }
         }
 #endif
@@ -489,6 +499,11 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 
     MethodBindingHelper<&FJsEnvImpl::LoadModule>::Bind(Isolate, Context, Global, "__tgjsLoadModule", This);
 
+#if WITH_EDITOR
+    // 依赖图只在编辑器热重载时使用，运行时的require不需要每次都回调到c++
+    MethodBindingHelper<&FJsEnvImpl::AddModuleImport>::Bind(Isolate, Context, Global, "__tgjsAddModuleImport", This);
+#endif
+
     MethodBindingHelper<&FJsEnvImpl::LoadUEType>::Bind(Isolate, Context, PuertsObj, "loadUEType", This);
 
     MethodBindingHelper<&FJsEnvImpl::LoadCppType>::Bind(Isolate, Context, PuertsObj, "loadCPPType", This);
@@ -583,6 +598,12 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
     MethodBindingHelper<&FJsEnvImpl::ReleaseManualReleaseDelegate>::Bind(
         Isolate, Context, PuertsObj, "releaseManualReleaseDelegate", This);
 
+#if !defined(WITH_QUICKJS)
+    MethodBindingHelper<&FJsEnvImpl::PostGroupMessage>::Bind(Isolate, Context, PuertsObj, "postMessage", This);
+
+    MethodBindingHelper<&FJsEnvImpl::SetGroupMessageHandler>::Bind(Isolate, Context, PuertsObj, "setMessageHandler", This);
+#endif
+
     ArrayTemplate = v8::UniquePersistent<v8::FunctionTemplate>(Isolate, FScriptArrayWrapper::ToFunctionTemplate(Isolate));
 
     SetTemplate = v8::UniquePersistent<v8::FunctionTemplate>(Isolate, FScriptSetWrapper::ToFunctionTemplate(Isolate));
@@ -628,6 +649,9 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
         Isolate, PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "getESMMain")).ToLocalChecked().As<v8::Function>());
 
     ReloadJs.Reset(Isolate, PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "__reload")).ToLocalChecked().As<v8::Function>());
+
+    ReloadGraphJs.Reset(
+        Isolate, PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "__reloadGraph")).ToLocalChecked().As<v8::Function>());
 #if !PUERTS_FORCE_CPP_UFUNCTION
     MergePrototype.Reset(
         Isolate, PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "__mergePrototype")).ToLocalChecked().As<v8::Function>());
@@ -638,14 +662,39 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 
     GenListApply.Reset(
         Isolate, PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "__genListApply")).ToLocalChecked().As<v8::Function>());
-#if defined(WITH_V8_BYTECODE)
-    GenEmptyCode.Reset(
-        Isolate, PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "generateEmptyCode")).ToLocalChecked().As<v8::Function>());
-#endif
 
     DelegateProxiesCheckerHandler =
         FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::CheckDelegateProxies), 1);
 
+#if !defined(WITH_QUICKJS)
+    HeapLimitGuard = std::make_unique<FHeapLimitGuard>(Isolate);
+    HeapLimitGuard->SetCleanupCallback(
+        [this]()
+        {
+            // 释放已失效的delegate及其js回调、等待生成code cache的脚本，之后的完整GC才能回收它们
+            CheckDelegateProxies(0);
+            if (RuntimeCodeCache)
+            {
+                RuntimeCodeCache->DiscardPending();
+            }
+            ObjectMap.Compact();
+            StructCache.Compact();
+            ContainerCache.Compact();
+        });
+    HeapLimitCheckerHandler =
+        FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::CheckHeapLimit), 0);
+
+    if (!InFlags.Contains(TEXT("--no-runtime-code-cache")))
+    {
+        RuntimeCodeCache = std::make_unique<FRuntimeCodeCache>(FPaths::ProjectSavedDir() / TEXT("PuertsCodeCache"));
+        RuntimeCodeCacheHandler =
+            FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::FlushRuntimeCodeCache), 1);
+    }
+
+    SoftObjectLoadHandler =
+        FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::ResolveSoftObjectLoads), 0);
+#endif
+
     ManualReleaseCallbackMap.Reset(Isolate, v8::Map::New(Isolate));
 
     UserObjectRetainer.SetName(TEXT("Puerts_UserObjectRetainer"));
@@ -722,9 +771,15 @@ FJsEnvImpl::~FJsEnvImpl()
     Require.Reset();
     GetESMMain.Reset();
     ReloadJs.Reset();
+    ReloadGraphJs.Reset();
+    ModuleGraph.Empty();
     JsPromiseRejectCallback.Reset();
 
     FUETicker::GetCoreTicker().RemoveTicker(DelegateProxiesCheckerHandler);
+    FUETicker::GetCoreTicker().RemoveTicker(HeapLimitCheckerHandler);
+    FUETicker::GetCoreTicker().RemoveTicker(RuntimeCodeCacheHandler);
+    FUETicker::GetCoreTicker().RemoveTicker(SoftObjectLoadHandler);
+    FUETicker::GetCoreTicker().RemoveTicker(GroupMessageTickerHandler);
 
     {
         auto Isolate = MainIsolate;
@@ -860,6 +915,24 @@ FJsEnvImpl::~FJsEnvImpl()
             Inspector = nullptr;
         }
 
+        CpuProfileRecorder.reset();
+        IdleGCScheduler.reset();
+        HeapLimitGuard.reset();
+#if !defined(WITH_QUICKJS)
+        PendingSoftObjectLoads.Empty();
+        CompletedSoftObjectLoads.Empty();
+        GroupMessageRouter = nullptr;
+        GroupMessageInbox.Empty();
+        GroupMessageHandler.Reset();
+        if (RuntimeCodeCache)
+        {
+            RuntimeCodeCache->Flush(Isolate);
+            RuntimeCodeCache->WaitForWrites();
+            Logger->Info(RuntimeCodeCache->GetStatistics());
+            RuntimeCodeCache.reset();
+        }
+#endif
+
         DynamicInvoker.Reset();
         MixinInvoker.Reset();
 
@@ -875,9 +948,6 @@ FJsEnvImpl::~FJsEnvImpl()
 #endif
         RemoveListItem.Reset();
         GenListApply.Reset();
-#if defined(WITH_V8_BYTECODE)
-        GenEmptyCode.Reset();
-#endif
     }
 
 #if !defined(ENGINE_INDEPENDENT_JSENV)
@@ -993,6 +1063,7 @@ void FJsEnvImpl::Merge(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8:
 void FJsEnvImpl::MergeObject(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope Isolatescope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -1039,6 +1110,7 @@ void FJsEnvImpl::MergeObject(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FJsEnvImpl::NewObjectByClass(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -1108,6 +1180,7 @@ void FJsEnvImpl::NewObjectByClass(const v8::FunctionCallbackInfo<v8::Value>& Inf
 void FJsEnvImpl::NewStructByScriptStruct(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -1160,6 +1233,35 @@ void FJsEnvImpl::LowMemoryNotification()
     MainIsolate->LowMemoryNotification();
 }
 
+bool FJsEnvImpl::OnFrameIdle(double IdleBudgetInSeconds)
+{
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    v8::Isolate::Scope IsolateScope(MainIsolate);
+    if (!IdleGCScheduler)
+    {
+        IdleGCScheduler = std::make_unique<FIdleGCScheduler>(
+            MainIsolate, reinterpret_cast<v8::Platform*>(IJsEnvModule::Get().GetV8Platform()));
+        IdleGCScheduler->SetCompactCallback(
+            [this]()
+            {
+                ObjectMap.Compact();
+                StructCache.Compact();
+                ContainerCache.Compact();
+            });
+    }
+    return IdleGCScheduler->OnFrameIdle(IdleBudgetInSeconds);
+}
+
+FString FJsEnvImpl::GetGCPauseReport()
+{
+    return IdleGCScheduler ? UTF8_TO_TCHAR(IdleGCScheduler->GetPauseReport().c_str()) : FString();
+}
+
 void FJsEnvImpl::RequestMinorGarbageCollectionForTesting()
 {
 #ifdef THREAD_SAFE
@@ -1180,6 +1282,44 @@ void FJsEnvImpl::RequestFullGarbageCollectionForTesting()
 #endif
 }
 
+bool FJsEnvImpl::StartCpuProfiling(const FString& Title, int32 SamplingIntervalUs)
+{
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    v8::Isolate::Scope IsolateScope(MainIsolate);
+    if (!CpuProfileRecorder)
+    {
+        CpuProfileRecorder.reset(CreateCpuProfileRecorder(MainIsolate));
+        if (!CpuProfileRecorder)
+        {
+            Logger->Warn(TEXT("cpu profiling is not supported by current backend"));
+            return false;
+        }
+    }
+    return CpuProfileRecorder->Start(TCHAR_TO_UTF8(*Title), SamplingIntervalUs);
+}
+
+bool FJsEnvImpl::StopCpuProfiling(const FString& Title, const FString& OutputPath)
+{
+    if (!CpuProfileRecorder)
+    {
+        return false;
+    }
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    v8::Isolate::Scope IsolateScope(MainIsolate);
+    FString FullPath = FPaths::ConvertRelativePathToFull(OutputPath);
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FullPath), true);
+    bool Success = CpuProfileRecorder->Stop(TCHAR_TO_UTF8(*Title), TCHAR_TO_UTF8(*FullPath));
+    if (!Success)
+    {
+        Logger->Error(FString::Printf(TEXT("stop cpu profiling [%s] fail, output: %s"), *Title, *FullPath));
+    }
+    return Success;
+}
+
 #if !defined(ENGINE_INDEPENDENT_JSENV)
 void FJsEnvImpl::FinishInjection(UClass* InClass)
 {
@@ -1506,6 +1646,13 @@ void FJsEnvImpl::ReloadModule(FName ModuleName, const FString& JsSource)
     JsHotReload(ModuleName, JsSource);
 }
 
+static FString NormalizeModulePath(const FString& Path)
+{
+    FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+    FPaths::NormalizeFilename(FullPath);
+    return FullPath;
+}
+
 void FJsEnvImpl::ReloadSource(const FString& Path, const std::string& JsSource)
 {
 #ifdef SINGLE_THREAD_VERIFY
@@ -1519,6 +1666,99 @@ void FJsEnvImpl::ReloadSource(const FString& Path, const std::string& JsSource)
     v8::HandleScope HandleScope(Isolate);
     auto Context = DefaultContext.Get(Isolate);
     v8::Context::Scope ContextScope(Context);
+
+    const FString ChangedKey = NormalizeModulePath(Path);
+    const FModuleGraphNode* ChangedNode = ModuleGraph.Find(ChangedKey);
+    bool IsESModule = false;
+#ifndef WITH_QUICKJS
+    for (auto& KV : PathToModule)
+    {
+        if (NormalizeModulePath(KV.Key) == ChangedKey)
+        {
+            IsESModule = true;
+            break;
+        }
+    }
+#endif
+    // 没有被其他模块import的commonjs模块沿用原来的热替换(Debugger.setScriptSource),
+    // 否则按依赖图只重新执行修改的模块和它的importer,其他模块(包括esm的编译结果)保持不动
+    if (ChangedNode && (IsESModule || ChangedNode->Importers.Num() > 0))
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        TArray<FString> Affected = CollectAffectedModules(ChangedKey);
+        TSet<FString> AffectedSet(Affected);
+
+#ifndef WITH_QUICKJS
+        for (auto It = PathToModule.CreateIterator(); It; ++It)
+        {
+            if (AffectedSet.Contains(NormalizeModulePath(It->Key)))
+            {
+                auto ModuleInfoIt = FindModuleInfo(It->Value.Get(Isolate));
+                if (ModuleInfoIt != HashToModuleInfo.end())
+                {
+                    delete ModuleInfoIt->second;
+                    HashToModuleInfo.erase(ModuleInfoIt);
+                }
+                It.RemoveCurrent();
+            }
+        }
+#endif
+
+        auto AffectedPaths = v8::Array::New(Isolate);
+        auto RootPaths = v8::Array::New(Isolate);
+        for (int i = 0; i < Affected.Num(); i++)
+        {
+            FModuleGraphNode& Node = ModuleGraph[Affected[i]];
+            AffectedPaths->Set(Context, i, FV8Utils::ToV8String(Isolate, Node.ModulePath)).Check();
+            if (Node.Importers.Num() == 0)
+            {
+                RootPaths->Set(Context, RootPaths->Length(), FV8Utils::ToV8String(Isolate, Node.ModulePath)).Check();
+            }
+        }
+        if (RootPaths->Length() == 0)
+        {
+            // 循环依赖,没有外部入口,从修改的模块开始重新执行
+            RootPaths->Set(Context, 0, FV8Utils::ToV8String(Isolate, ChangedNode->ModulePath)).Check();
+        }
+        // 重新执行时会重新记录,这里先去掉受影响模块的出边,避免删掉的import残留
+        // 记下去掉的边,重新执行失败时恢复,否则下次修改时这些importer不会被重新加载
+        TArray<TPair<FString, FString>> RemovedEdges;
+        for (auto& KV : ModuleGraph)
+        {
+            for (const FString& Key : Affected)
+            {
+                if (KV.Value.Importers.Remove(Key) > 0)
+                {
+                    RemovedEdges.Emplace(KV.Key, Key);
+                }
+            }
+        }
+
+        Logger->Info(FString::Printf(TEXT("reload js [%s], %d modules affected"), *Path, Affected.Num()));
+        v8::TryCatch TryCatch(Isolate);
+        v8::Local<v8::Value> Args[] = {FV8Utils::ToV8String(Isolate, ChangedNode->ModulePath), AffectedPaths, RootPaths};
+        v8::Local<v8::Value> Result;
+        const bool Succeeded =
+            ReloadGraphJs.Get(Isolate)->Call(Context, v8::Undefined(Isolate), 3, Args).ToLocal(&Result) && Result->IsTrue();
+        if (TryCatch.HasCaught())
+        {
+            Logger->Error(FString::Printf(TEXT("reload module exception %s"), *FV8Utils::TryCatchToString(Isolate, &TryCatch)));
+        }
+        if (!Succeeded)
+        {
+            for (const auto& Edge : RemovedEdges)
+            {
+                if (FModuleGraphNode* Node = ModuleGraph.Find(Edge.Key))
+                {
+                    Node->Importers.Add(Edge.Value);
+                }
+            }
+        }
+        Logger->Info(
+            FString::Printf(TEXT("reload js [%s] finished in %.2fms"), *Path, (FPlatformTime::Seconds() - StartTime) * 1000));
+        return;
+    }
+
     auto LocalReloadJs = ReloadJs.Get(Isolate);
 
     Logger->Info(FString::Printf(TEXT("reload js [%s]"), *Path));
@@ -1534,6 +1774,50 @@ void FJsEnvImpl::ReloadSource(const FString& Path, const std::string& JsSource)
     }
 }
 
+void FJsEnvImpl::RecordModuleImport(const FString& ImporterPath, const FString& ImportedPath)
+{
+#if WITH_EDITOR
+    FModuleGraphNode& Imported = ModuleGraph.FindOrAdd(NormalizeModulePath(ImportedPath));
+    if (Imported.ModulePath.IsEmpty())
+    {
+        Imported.ModulePath = ImportedPath;
+    }
+    if (!ImporterPath.IsEmpty())
+    {
+        const FString ImporterKey = NormalizeModulePath(ImporterPath);
+        Imported.Importers.Add(ImporterKey);
+        FModuleGraphNode& Importer = ModuleGraph.FindOrAdd(ImporterKey);
+        if (Importer.ModulePath.IsEmpty())
+        {
+            Importer.ModulePath = ImporterPath;
+        }
+    }
+#endif
+}
+
+TArray<FString> FJsEnvImpl::CollectAffectedModules(const FString& ChangedKey)
+{
+    TArray<FString> Result;
+    TSet<FString> Visited;
+    Result.Add(ChangedKey);
+    Visited.Add(ChangedKey);
+    for (int i = 0; i < Result.Num(); i++)
+    {
+        if (const FModuleGraphNode* Node = ModuleGraph.Find(Result[i]))
+        {
+            for (const FString& Importer : Node->Importers)
+            {
+                if (!Visited.Contains(Importer))
+                {
+                    Visited.Add(Importer);
+                    Result.Add(Importer);
+                }
+            }
+        }
+    }
+    return Result;
+}
+
 void FJsEnvImpl::OnSourceLoaded(std::function<void(const FString&)> Callback)
 {
     OnSourceLoadedCallback = Callback;
@@ -1901,9 +2185,18 @@ v8::Local<v8::Value> FJsEnvImpl::FindOrAddDelegate(v8::Isolate* Isolate, v8::Loc
         {
             Function = MulticastDelegateProperty->SignatureFunction;
         }
-        DelegateMap[DelegatePtr] = {v8::UniquePersistent<v8::Object>(Isolate, JSObject), TWeakObjectPtr<UObject>(Owner),
+        auto& DelegateInfo = DelegateMap[DelegatePtr];
+        DelegateInfo = {v8::UniquePersistent<v8::Object>(Isolate, JSObject), TWeakObjectPtr<UObject>(Owner),
             DelegateProperty, MulticastDelegateProperty, Function, PassByPointer, nullptr,
             v8::UniquePersistent<v8::Array>(Isolate, v8::Array::New(Isolate))};
+        if (DelegateInfo.Owner.IsValid())
+        {
+            DelegatesByOwner.FindOrAdd(Owner).Add(DelegatePtr);
+        }
+        else
+        {
+            ScheduleDelegateCleanup(DelegatePtr);
+        }
         return JSObject;
     }
 }
@@ -2115,8 +2408,19 @@ void FJsEnvImpl::NotifyUObjectDeleted(const class UObjectBase* ObjectBase, int32
 
     TsFunctionMap.Remove((UFunction*) ObjectBase);
     MixinFunctionMap.Remove((UFunction*) ObjectBase);
+    JsCallbackPrototypeMap.erase((UFunction*) ObjectBase);
     ContainerMeta.NotifyElementTypeDeleted((UField*) ObjectBase);
 
+    // GC过程中不能操作delegate和proxy，先记下来，到CheckDelegateProxies里再清理
+    if (auto DelegatesPtr = DelegatesByOwner.Find(ObjectBase))
+    {
+        for (void* DelegatePtr : *DelegatesPtr)
+        {
+            ScheduleDelegateCleanup(DelegatePtr);
+        }
+        DelegatesByOwner.Remove(ObjectBase);
+    }
+
     auto CallbacksPtr = AutoReleaseCallbacksMap.Find((UObject*) ObjectBase);
     if (CallbacksPtr)
     {
@@ -2134,7 +2438,10 @@ void FJsEnvImpl::NotifyUObjectDeleted(const class UObjectBase* ObjectBase, int32
 
 void FJsEnvImpl::TryReleaseType(UStruct* Struct)
 {
-    TypeToTemplateInfoMap.Remove(Struct);
+    if (TypeToTemplateInfoMap.Remove(Struct) > 0)
+    {
+        FPropertyTranslator::InvalidatePropertyValidity();
+    }
 }
 
 // fix ScriptCore.cpp UObject::SkipFunction crash when Function has no parameters
@@ -2409,6 +2716,7 @@ bool FJsEnvImpl::AddToDelegate(
         {
             delete ((FScriptDelegate*) Iter->first);
         }
+        RemoveDelegateFromOwner(DelegatePtr, Iter->second.Owner);
         DelegateMap.erase(Iter);
         return false;
     }
@@ -2598,6 +2906,7 @@ FScriptDelegate FJsEnvImpl::NewDelegate(v8::Isolate* Isolate, v8::Local<v8::Cont
 void FJsEnvImpl::ReleaseManualReleaseDelegate(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -2728,61 +3037,243 @@ bool FJsEnvImpl::ClearDelegate(v8::Isolate* Isolate, v8::Local<v8::Context>& Con
     return true;
 }
 
-bool FJsEnvImpl::CheckDelegateProxies(float Tick)
+bool FJsEnvImpl::CheckHeapLimit(float Tick)
 {
 #ifdef SINGLE_THREAD_VERIFY
     ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
 #endif
+    if (!HeapLimitGuard)
+    {
+        return true;
+    }
     auto Isolate = MainIsolate;
 #ifdef THREAD_SAFE
     v8::Locker Locker(Isolate);
 #endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    std::string Report;
+    if (HeapLimitGuard->ProcessPending(Report))
+    {
+        Logger->Error(UTF8_TO_TCHAR(Report.c_str()));
+    }
+    return true;
+}
+
+#if !defined(WITH_QUICKJS)
+void FJsEnvImpl::InitGroupMessaging(int32 InGroupIndex, FGroupMessageRouter InRouter)
+{
+    GroupIndex = InGroupIndex;
+    GroupMessageRouter = std::move(InRouter);
+    SetGroupMessageDispatchOnTicker(GroupMessageRouter != nullptr);
+}
 
-    std::vector<void*> PendingToRemove;
-    for (auto& KV : DelegateMap)
+void FJsEnvImpl::SetGroupMessageDispatchOnTicker(bool Enable)
+{
+    FUETicker::GetCoreTicker().RemoveTicker(GroupMessageTickerHandler);
+    if (Enable)
+    {
+        GroupMessageTickerHandler =
+            FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::DispatchGroupMessages), 0);
+    }
+}
+
+void FJsEnvImpl::EnqueueGroupMessage(FGroupMessage&& Message)
+{
+    GroupMessageInbox.Enqueue(MoveTemp(Message));
+}
+
+bool FJsEnvImpl::DispatchGroupMessages(float Tick)
+{
+    if (GroupMessageInbox.IsEmpty())
     {
-        if (!KV.second.Owner.IsValid())
+        return true;
+    }
+    auto Isolate = MainIsolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    auto Context = DefaultContext.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+
+    FGroupMessage Message;
+    while (GroupMessageInbox.Dequeue(Message))
+    {
+        // 没设置处理函数时消息直接丢弃
+        if (GroupMessageHandler.IsEmpty())
+        {
+            continue;
+        }
+        v8::TryCatch TryCatch(Isolate);
+        v8::Local<v8::Value> Value;
+        if (Message.Data.Num() > 0)
+        {
+            v8::ValueDeserializer Deserializer(Isolate, Message.Data.GetData(), Message.Data.Num());
+            if (!Deserializer.ReadHeader(Context).FromMaybe(false) || !Deserializer.ReadValue(Context).ToLocal(&Value))
+            {
+                Logger->Error(FString::Printf(TEXT("deserialize message from env %d fail: %s"), Message.Sender,
+                    *FV8Utils::TryCatchToString(Isolate, &TryCatch)));
+                continue;
+            }
+        }
+        else
         {
-            PendingToRemove.push_back(KV.first);
+            Value = FV8Utils::ToV8String(Isolate, Message.Text);
+        }
+        v8::Local<v8::Value> Args[] = {Value, v8::Integer::New(Isolate, Message.Sender)};
+        __USE(GroupMessageHandler.Get(Isolate)->Call(Context, v8::Undefined(Isolate), 2, Args));
+        if (TryCatch.HasCaught())
+        {
+            Logger->Error(FString::Printf(TEXT("message handler throw: %s"), *FV8Utils::TryCatchToString(Isolate, &TryCatch)));
         }
     }
+    Isolate->PerformMicrotaskCheckpoint();
+    return true;
+}
 
-    if (PendingToRemove.size() > 0)
+void FJsEnvImpl::PostGroupMessage(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+    v8::Context::Scope ContextScope(Context);
+
+    CHECK_V8_ARGS(EArgInt32);
+
+    if (!GroupMessageRouter)
+    {
+        FV8Utils::ThrowException(Isolate, "postMessage is only available in a JsEnvGroup");
+        return;
+    }
+
+    // 序列化失败时V8已抛出DataCloneError，UObject等宿主对象不能跨虚拟机传递
+    v8::ValueSerializer Serializer(Isolate);
+    Serializer.WriteHeader();
+    if (!Serializer.WriteValue(Context, Info[1]).FromMaybe(false))
     {
+        return;
+    }
+    std::pair<uint8_t*, size_t> Buffer = Serializer.Release();
+    FGroupMessage Message;
+    Message.Sender = GroupIndex;
+    Message.Data.Append(Buffer.first, static_cast<int32>(Buffer.second));
+    free(Buffer.first);
+
+    Info.GetReturnValue().Set(GroupMessageRouter(Info[0]->Int32Value(Context).ToChecked(), MoveTemp(Message)));
+}
+
+void FJsEnvImpl::SetGroupMessageHandler(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+    v8::Context::Scope ContextScope(Context);
+
+    if (Info[0]->IsFunction())
+    {
+        GroupMessageHandler.Reset(Isolate, Info[0].As<v8::Function>());
+    }
+    else
+    {
+        GroupMessageHandler.Reset();
+    }
+}
+#endif
+
+bool FJsEnvImpl::FlushRuntimeCodeCache(float Tick)
+{
+#if !defined(WITH_QUICKJS)
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+    if (RuntimeCodeCache)
+    {
+        auto Isolate = MainIsolate;
+#ifdef THREAD_SAFE
+        v8::Locker Locker(Isolate);
+#endif
+        v8::Isolate::Scope IsolateScope(Isolate);
+        RuntimeCodeCache->Flush(Isolate);
+    }
+#endif
+    return true;
+}
+
+bool FJsEnvImpl::CheckDelegateProxies(float Tick)
+{
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+    auto Isolate = MainIsolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+
+    // 只处理Owner删除时登记的delegate，开销和死亡的数量成正比，与绑定总数无关
+    if (DelegateCleanupCandidates.size() > 0)
+    {
+        std::vector<void*> Candidates;
+        Candidates.swap(DelegateCleanupCandidates);
+
         v8::Isolate::Scope IsolateScope(Isolate);
         v8::HandleScope HandleScope(Isolate);
         v8::Local<v8::Context> Context = DefaultContext.Get(Isolate);
         v8::Context::Scope ContextScope(Context);
-        for (int i = 0; i < PendingToRemove.size(); ++i)
+        for (void* DelegatePtr : Candidates)
         {
-            ClearDelegate(Isolate, Context, PendingToRemove[i]);
-            if (!DelegateMap[PendingToRemove[i]].PassByPointer)
+            auto Iter = DelegateMap.find(DelegatePtr);
+            if (Iter == DelegateMap.end())
             {
-                delete ((FScriptDelegate*) PendingToRemove[i]);
+                continue;
             }
-            DelegateMap.erase(PendingToRemove[i]);
+            Iter->second.CleanupScheduled = false;
+            // 登记后该地址可能已被新的delegate复用
+            if (Iter->second.Owner.IsValid())
+            {
+                continue;
+            }
+            ClearDelegate(Isolate, Context, DelegatePtr);
+            if (!Iter->second.PassByPointer)
+            {
+                delete ((FScriptDelegate*) DelegatePtr);
+            }
+            RemoveDelegateFromOwner(DelegatePtr, Iter->second.Owner);
+            DelegateMap.erase(Iter);
         }
     }
 
-    // Collecting invalid function translators to remove.
-    std::vector<UFunction*> PendingToRemoveJsCallbacks;
-    for (auto& KV : JsCallbackPrototypeMap)
+    return true;
+}
+
+void FJsEnvImpl::ScheduleDelegateCleanup(void* DelegatePtr)
+{
+    auto Iter = DelegateMap.find(DelegatePtr);
+    if (Iter != DelegateMap.end() && !Iter->second.CleanupScheduled)
     {
-        if ((nullptr == KV.first) || (!KV.second->IsValid()))
-        {
-            PendingToRemoveJsCallbacks.push_back(KV.first);
-        }
+        Iter->second.CleanupScheduled = true;
+        DelegateCleanupCandidates.push_back(DelegatePtr);
     }
+}
 
-    if (PendingToRemoveJsCallbacks.size() > 0)
+void FJsEnvImpl::RemoveDelegateFromOwner(void* DelegatePtr, const TWeakObjectPtr<UObject>& Owner)
+{
+    // Owner已被删除时整个条目在NotifyUObjectDeleted里移除过了，这里只处理PendingKill等仍存活的Owner
+    UObject* OwnerObject = Owner.Get(true);
+    if (!OwnerObject)
+    {
+        return;
+    }
+    if (auto DelegatesPtr = DelegatesByOwner.Find(OwnerObject))
     {
-        for (int32 i = 0; i < PendingToRemoveJsCallbacks.size(); i++)
+        DelegatesPtr->Remove(DelegatePtr);
+        if (DelegatesPtr->Num() == 0)
         {
-            JsCallbackPrototypeMap.erase(PendingToRemoveJsCallbacks[i]);
+            DelegatesByOwner.Remove(OwnerObject);
         }
     }
-
-    return true;
 }
 
 FPropertyTranslator* FJsEnvImpl::GetContainerPropertyTranslator(PropertyMacro* Property)
@@ -2823,6 +3314,7 @@ v8::Local<v8::Value> FJsEnvImpl::FindOrAddContainer(
         PassByPointer ? FScriptArrayWrapper::OnGarbageCollected : FScriptArrayWrapper::OnGarbageCollectedWithFree, PassByPointer,
         EArray);
     DataTransfer::SetPointer(Isolate, Result, GetContainerPropertyTranslator(Property), 1);
+    DataTransfer::SetPointer(Isolate, Result, nullptr, 2);
     return Result;
 }
 
@@ -2981,6 +3473,20 @@ void FJsEnvImpl::UnBindContainer(void* Ptr)
     ContainerCache.Remove(Ptr);
 }
 
+FScriptArrayHashIndex* FJsEnvImpl::AddArrayHashIndex(FScriptArray* Ptr)
+{
+    auto CacheItem = ContainerCache.Find(Ptr);
+    if (!CacheItem || CacheItem->Type != EArray)
+    {
+        return nullptr;
+    }
+    if (!CacheItem->ArrayHashIndex)
+    {
+        CacheItem->ArrayHashIndex = std::make_unique<FScriptArrayHashIndex>();
+    }
+    return CacheItem->ArrayHashIndex.get();
+}
+
 std::shared_ptr<FStructWrapper> FJsEnvImpl::GetStructWrapper(UStruct* InStruct, bool& IsReuseTemplate)
 {
     const auto FullName = InStruct->GetFullName();
@@ -3182,6 +3688,96 @@ v8::Local<v8::Value> FJsEnvImpl::AddSoftObjectPtr(
     return JSObject;
 }
 
+#if !defined(WITH_QUICKJS)
+v8::Local<v8::Value> FJsEnvImpl::LoadSoftObjectAsync(v8::Isolate* Isolate, v8::Local<v8::Context> Context,
+    const FSoftObjectPath& Path, UClass* PropertyClass, UClass* MetaClass)
+{
+    auto Resolver = v8::Promise::Resolver::New(Context).ToLocalChecked();
+    auto Promise = Resolver->GetPromise();
+    if (Path.IsNull())
+    {
+        __USE(Resolver->Resolve(Context, v8::Undefined(Isolate)));
+        return Promise;
+    }
+    if (UObject* Obj = Path.ResolveObject())
+    {
+        __USE(Resolver->Resolve(Context, FSoftObjectWrapper::IsExpectType(Obj, PropertyClass, MetaClass)
+                                             ? FindOrAdd(Isolate, Context, Obj->GetClass(), Obj)
+                                             : v8::Undefined(Isolate).As<v8::Value>()));
+        return Promise;
+    }
+
+    auto& Waiters = PendingSoftObjectLoads.FindOrAdd(Path);
+    FSoftObjectLoadWaiter Waiter;
+    Waiter.Resolver.Reset(Isolate, Resolver);
+    Waiter.PropertyClass = PropertyClass;
+    Waiter.MetaClass = MetaClass;
+    Waiters.Add(MoveTemp(Waiter));
+    if (Waiters.Num() == 1)
+    {
+        std::weak_ptr<int> JsEnvLifeCycleTracker = GetJsEnvLifeCycleTracker();
+        LoadPackageAsync(Path.GetLongPackageName(),
+            FLoadPackageAsyncDelegate::CreateLambda(
+                [this, Path, JsEnvLifeCycleTracker](const FName&, UPackage*, EAsyncLoadingResult::Type)
+                {
+                    if (!JsEnvLifeCycleTracker.expired())
+                    {
+                        CompletedSoftObjectLoads.Add(Path);
+                    }
+                }));
+    }
+    return Promise;
+}
+#endif
+
+bool FJsEnvImpl::ResolveSoftObjectLoads(float Tick)
+{
+#if !defined(WITH_QUICKJS)
+    if (CompletedSoftObjectLoads.Num() == 0)
+    {
+        return true;
+    }
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+    auto Isolate = MainIsolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    auto Context = DefaultContext.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+
+    TArray<FSoftObjectPath> Completed = MoveTemp(CompletedSoftObjectLoads);
+    CompletedSoftObjectLoads.Reset();
+    for (const auto& Path : Completed)
+    {
+        auto WaitersPtr = PendingSoftObjectLoads.Find(Path);
+        if (!WaitersPtr)
+        {
+            continue;
+        }
+        TArray<FSoftObjectLoadWaiter> Waiters = MoveTemp(*WaitersPtr);
+        PendingSoftObjectLoads.Remove(Path);
+
+        UObject* Obj = Path.ResolveObject();
+        for (auto& Waiter : Waiters)
+        {
+            v8::Local<v8::Value> Result = v8::Undefined(Isolate);
+            if (Obj && FSoftObjectWrapper::IsExpectType(Obj, Waiter.PropertyClass.Get(), Waiter.MetaClass.Get()))
+            {
+                Result = FindOrAdd(Isolate, Context, Obj->GetClass(), Obj);
+            }
+            __USE(Waiter.Resolver.Get(Isolate)->Resolve(Context, Result));
+        }
+    }
+    // 不在js调用栈里，需要手动执行then回调
+    Isolate->PerformMicrotaskCheckpoint();
+#endif
+    return true;
+}
+
 v8::Local<v8::Value> FJsEnvImpl::UETypeToJsClass(v8::Isolate* Isolate, v8::Local<v8::Context> Context, UField* Type)
 {
     if (const auto Struct = Cast<UStruct>(Type))
@@ -3262,6 +3858,7 @@ v8::Local<v8::Value> FJsEnvImpl::UETypeToJsClass(v8::Isolate* Isolate, v8::Local
 void FJsEnvImpl::LoadUEType(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -3325,6 +3922,7 @@ void FJsEnvImpl::LoadCppType(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FJsEnvImpl::UEClassToJSClass(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -3356,6 +3954,7 @@ void FJsEnvImpl::UEClassToJSClass(const v8::FunctionCallbackInfo<v8::Value>& Inf
 void FJsEnvImpl::SetJsTakeRefInTs(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
     CHECK_V8_ARGS(EArgObject);
 
@@ -3394,6 +3993,7 @@ bool FJsEnvImpl::GetContainerTypeProperty(v8::Local<v8::Context> Context, v8::Lo
 void FJsEnvImpl::NewContainer(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -3531,6 +4131,113 @@ bool FJsEnvImpl::LoadFile(const FString& RequiringDir, const FString& ModuleName
     return true;
 }
 
+#if !defined(WITH_QUICKJS)
+// 小于该大小的文件映射时的页对齐开销大于收益
+static const int64 MinMappedSourceSize = 16 * 1024;
+
+struct FMappedModuleFile
+{
+    // Region必须先于Handle释放
+    TUniquePtr<IMappedFileHandle> Handle;
+    TUniquePtr<IMappedFileRegion> Region;
+
+    static std::shared_ptr<FMappedModuleFile> Open(IJSModuleLoader& ModuleLoader, const FString& Path)
+    {
+        TUniquePtr<IMappedFileHandle> Handle(ModuleLoader.OpenMapped(Path));
+        if (!Handle || Handle->GetFileSize() < MinMappedSourceSize)
+        {
+            return nullptr;
+        }
+        TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion());
+        if (!Region)
+        {
+            return nullptr;
+        }
+        auto Ret = std::make_shared<FMappedModuleFile>();
+        Ret->Handle = MoveTemp(Handle);
+        Ret->Region = MoveTemp(Region);
+        return Ret;
+    }
+};
+#endif
+
+v8::MaybeLocal<v8::String> FJsEnvImpl::LoadModuleSource(v8::Isolate* Isolate, const FString& Path, bool WrapAsCommonJS)
+{
+    std::shared_ptr<const void> Owner;
+    const char* Source = nullptr;
+    size_t Length = 0;
+    TArray<uint8> Data;
+
+#if !defined(WITH_QUICKJS)
+    if (auto Mapped = FMappedModuleFile::Open(*ModuleLoader, Path))
+    {
+        Source = reinterpret_cast<const char*>(Mapped->Region->GetMappedPtr());
+        Length = Mapped->Region->GetMappedSize();
+        Owner = std::move(Mapped);
+    }
+    else
+#endif
+    {
+        if (!ModuleLoader->Load(Path, Data))
+        {
+            return v8::MaybeLocal<v8::String>();
+        }
+        Source = reinterpret_cast<const char*>(Data.GetData());
+        Length = Data.Num();
+    }
+
+    auto Buffer = reinterpret_cast<const uint8*>(Source);
+    std::string Converted;
+    if (Length >= 2 && !(Length & 1) && ((Buffer[0] == 0xff && Buffer[1] == 0xfe) || (Buffer[0] == 0xfe && Buffer[1] == 0xff)))
+    {
+        FString Content;
+        FFileHelper::BufferToString(Content, Buffer, Length);
+        FTCHARToUTF8 Utf8(*Content);
+        Converted.assign(Utf8.Get(), Utf8.Length());
+        Source = Converted.data();
+        Length = Converted.size();
+        Owner.reset();
+    }
+    else if (Length >= 3 && Buffer[0] == 0xef && Buffer[1] == 0xbb && Buffer[2] == 0xbf)
+    {
+        // Skip over UTF-8 BOM if there is one
+        Source += 3;
+        Length -= 3;
+    }
+
+    if (WrapAsCommonJS)
+    {
+        // 和modular.js里的包装保持一致
+        static const char Prefix[] = "(function (exports, require, module, __filename, __dirname) { ";
+        static const char Suffix[] = "\n});";
+        auto Wrapped = std::make_shared<std::string>();
+        Wrapped->reserve(sizeof(Prefix) + Length + sizeof(Suffix));
+        Wrapped->append(Prefix).append(Source, Length).append(Suffix);
+        Source = Wrapped->data();
+        Length = Wrapped->size();
+        Owner = std::move(Wrapped);
+    }
+#if !defined(WITH_QUICKJS)
+    else if (!Owner)
+    {
+        if (Converted.empty())
+        {
+            // TArray移动后堆内存地址不变
+            Owner = std::make_shared<TArray<uint8>>(MoveTemp(Data));
+        }
+        else
+        {
+            auto Holder = std::make_shared<std::string>(std::move(Converted));
+            Source = Holder->data();
+            Owner = std::move(Holder);
+        }
+    }
+    return FExternalSourceResource::NewString(Isolate, Source, Length, std::move(Owner));
+#else
+    return v8::String::NewFromUtf8(Isolate, Source, v8::NewStringType::kNormal, static_cast<int>(Length));
+#endif
+}
+
 #ifndef WITH_QUICKJS
 std::unordered_multimap<int, FJsEnvImpl::FModuleInfo*>::iterator FJsEnvImpl::FindModuleInfo(v8::Local<v8::Module> Module)
 {
@@ -3658,12 +4365,6 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
 
     Logger->Info(FString::Printf(TEXT("Fetch ES Module: %s"), *FileName));
     TArray<uint8> Data;
-    if (!ModuleLoader->Load(FileName, Data))
-    {
-        FV8Utils::ThrowException(MainIsolate, FString::Printf(TEXT("can not load [%s]"), *FileName));
-        return v8::MaybeLocal<v8::Module>();
-    }
-
     v8::Local<v8::String> Source;
 
     v8::ScriptCompiler::CachedData* CachedCode = nullptr;
@@ -3671,6 +4372,11 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
 #if defined(WITH_V8_BYTECODE)
     if (FileName.EndsWith(TEXT(".mbc")))
     {
+        if (!ModuleLoader->Load(FileName, Data))
+        {
+            FV8Utils::ThrowException(MainIsolate, FString::Printf(TEXT("can not load [%s]"), *FileName));
+            return v8::MaybeLocal<v8::Module>();
+        }
         FCodeCacheHeader* CodeCacheHeader = (FCodeCacheHeader*) Data.GetData();
         if (CodeCacheHeader->FlagHash != Expect_FlagHash)
         {
@@ -3685,25 +4391,23 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
             CodeCacheHeader->ReadOnlySnapshotChecksum = Expect_ReadOnlySnapshotChecksum;
         }
 #endif
-        static constexpr uint32_t kModuleFlagMask = (1 << 31);
-        uint32_t Len = CodeCacheHeader->SourceHash & ~kModuleFlagMask;
-        v8::Local<v8::Value> Args[] = {v8::Integer::New(Isolate, Len)};
-        v8::Local<v8::Value> Ret;
-        if (!GenEmptyCode.Get(Isolate)->Call(Context, v8::Undefined(Isolate), 1, Args).ToLocal(&Ret) || !Ret->IsString())
+        uint32_t Len = GetSourceLengthFromCodeCache(Data.GetData(), Data.Num());
+        if (!FPlaceholderSourceResource::NewString(Isolate, Len).ToLocal(&Source))
         {
             FV8Utils::ThrowException(MainIsolate, FString::Printf(TEXT("generate code for bytecode [%s] fail!"), *FileName));
             return v8::MaybeLocal<v8::Module>();
         }
         CachedCode = new v8::ScriptCompiler::CachedData(Data.GetData(), Data.Num());    // will delete by ~Source
         Options = v8::ScriptCompiler::CompileOptions::kConsumeCodeCache;
-        Source = Ret.As<v8::String>();
     }
     else
 #endif
     {
-        FString Script;
-        FFileHelper::BufferToString(Script, Data.GetData(), Data.Num());
-        Source = FV8Utils::ToV8String(Isolate, Script);
+        if (!LoadModuleSource(Isolate, FileName, false).ToLocal(&Source))
+        {
+            FV8Utils::ThrowException(MainIsolate, FString::Printf(TEXT("can not load [%s]"), *FileName));
+            return v8::MaybeLocal<v8::Module>();
+        }
     }
 
 #if V8_MAJOR_VERSION > 8
@@ -3723,6 +4427,7 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
     }
 
     PathToModule.Add(FileName, v8::Global<v8::Module>(Isolate, Module));
+    RecordModuleImport(TEXT(""), FileName);
     FModuleInfo* Info = new FModuleInfo;
     Info->Module.Reset(Isolate, Module);
     HashToModuleInfo.emplace(Module->GetIdentityHash(), Info);
@@ -3775,6 +4480,7 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
                 {
                     return v8::MaybeLocal<v8::Module>();
                 }
+                RecordModuleImport(FileName, OutPath);
                 Info->ResolveCache.Add(RefModuleName, v8::Global<v8::Module>(Isolate, RefModule.ToLocalChecked()));
                 continue;
             }
@@ -3788,6 +4494,10 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
                 MainIsolate, FString::Printf(TEXT("can not resolve [%s], import by [%s]"), *RefModuleName, *FileName));
             return v8::MaybeLocal<v8::Module>();
         }
+        if (!OutPath.IsEmpty())
+        {
+            RecordModuleImport(FileName, OutPath);
+        }
 
         Info->ResolveCache.Add(RefModuleName, v8::Global<v8::Module>(Isolate, RefModule.ToLocalChecked()));
     }
@@ -3941,12 +4651,14 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
 #else
     v8::ScriptOrigin Origin(Name);
 #endif
-    v8::Local<v8::String> Source = Info[0]->ToString(Context).ToLocalChecked();
+    v8::Local<v8::String> Source;
 
-#if defined(WITH_V8_BYTECODE)
+#if !defined(WITH_QUICKJS)
     v8::ScriptCompiler::CachedData* CachedCode = nullptr;
     uint8_t* Cache = nullptr;
     v8::ScriptCompiler::CompileOptions Options = v8::ScriptCompiler::CompileOptions::kNoCompileOptions;
+#endif
+#if defined(WITH_V8_BYTECODE)
     if (Info.Length() > 4)
     {
         if (Info[4]->IsArrayBuffer())
@@ -3964,12 +4676,47 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
                     Puerts, Warning, TEXT("FlagHash not match expect %u, but got %u"), Expect_FlagHash, CodeCacheHeader->FlagHash);
                 CodeCacheHeader->FlagHash = Expect_FlagHash;
             }
+            // 字节码模块不传源码，直接按头部记录的长度生成占位源码
+            if (!Info[0]->IsString() &&
+                !FPlaceholderSourceResource::NewString(Isolate, GetSourceLengthFromCodeCache(Cache, Length)).ToLocal(&Source))
+            {
+                delete CachedCode;
+                delete[] Cache;
+                FV8Utils::ThrowException(Isolate, FString::Printf(TEXT("generate code for bytecode [%s] fail!"), *ScriptUrl));
+                return;
+            }
+        }
+    }
+#endif
+    if (Source.IsEmpty())
+    {
+        Source = Info[0]->ToString(Context).ToLocalChecked();
+    }
+
+#if !defined(WITH_QUICKJS)
+    uint64 SourceHash = 0;
+    TArray<uint8> RuntimeCache;
+    bool RuntimeCacheRejected = false;
+    if (!CachedCode && RuntimeCodeCache)
+    {
+        SourceHash = RuntimeCodeCache->HashSource(Isolate, Source);
+        if (RuntimeCodeCache->Load(ScriptUrl, SourceHash, RuntimeCache))
+        {
+            // will delete by ~Source
+            CachedCode = new v8::ScriptCompiler::CachedData(RuntimeCache.GetData(), RuntimeCache.Num());
+            Options = v8::ScriptCompiler::CompileOptions::kConsumeCodeCache;
         }
     }
 
     v8::ScriptCompiler::Source ScriptSource(Source, Origin, CachedCode);
     auto Script = v8::ScriptCompiler::Compile(Context, &ScriptSource, Options);
-    if (CachedCode)
+    if (RuntimeCache.Num() > 0)
+    {
+        // 运行时缓存被拒绝时V8已经回退到从源码编译，只需重新生成
+        RuntimeCacheRejected = CachedCode->rejected;
+        RuntimeCodeCache->OnConsumed(ScriptUrl, RuntimeCacheRejected);
+    }
+    else if (CachedCode)
     {
         delete Cache;
         if (CachedCode->rejected)
@@ -3993,6 +4740,13 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
     }
     Info.GetReturnValue().Set(Result.ToLocalChecked());
 
+#if !defined(WITH_QUICKJS)
+    if (RuntimeCodeCache && SourceHash != 0 && (RuntimeCache.Num() == 0 || RuntimeCacheRejected))
+    {
+        RuntimeCodeCache->Add(Isolate, ScriptUrl, SourceHash, Script.ToLocalChecked()->GetUnboundScript());
+    }
+#endif
+
     if (OnSourceLoadedCallback)
     {
         OnSourceLoadedCallback(FormattedScriptUrl);
@@ -4061,15 +4815,15 @@ void FJsEnvImpl::LoadModule(const v8::FunctionCallbackInfo<v8::Value>& Info)
     CHECK_V8_ARGS(EArgString);
 
     FString Path = FV8Utils::ToFString(Isolate, Info[0]);
-    TArray<uint8> Data;
-    if (!ModuleLoader->Load(Path, Data))
-    {
-        FV8Utils::ThrowException(Isolate, "can not load module");
-        return;
-    }
 #if defined(WITH_V8_BYTECODE)
     if (Path.EndsWith(TEXT(".cbc")) || Path.EndsWith(TEXT(".mbc")))
     {
+        TArray<uint8> Data;
+        if (!ModuleLoader->Load(Path, Data))
+        {
+            FV8Utils::ThrowException(Isolate, "can not load module");
+            return;
+        }
         v8::Local<v8::ArrayBuffer> Ab = v8::ArrayBuffer::New(Info.GetIsolate(), Data.Num());
         void* Buff = DataTransfer::GetArrayBufferData(Ab);
         ::memcpy(Buff, Data.GetData(), Data.Num());
@@ -4078,10 +4832,26 @@ void FJsEnvImpl::LoadModule(const v8::FunctionCallbackInfo<v8::Value>& Info)
     else
 #endif
     {
-        Info.GetReturnValue().Set(FV8Utils::ToV8StringFromFileContent(Isolate, Data));
+        // 第二个参数为true时由这里包装CommonJS模块，避免在js里拼接出整份源码的拷贝
+        v8::Local<v8::String> Source;
+        if (!LoadModuleSource(Isolate, Path, Info.Length() > 1 && Info[1]->BooleanValue(Isolate)).ToLocal(&Source))
+        {
+            FV8Utils::ThrowException(Isolate, "can not load module");
+            return;
+        }
+        Info.GetReturnValue().Set(Source);
     }
 }
 
+void FJsEnvImpl::AddModuleImport(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+
+    CHECK_V8_ARGS(EArgString, EArgString);
+
+    RecordModuleImport(FV8Utils::ToFString(Isolate, Info[0]), FV8Utils::ToFString(Isolate, Info[1]));
+}
+
 void FJsEnvImpl::SetTimeout(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     CHECK_V8_ARGS(EArgFunction, EArgNumber);
@@ -4207,6 +4977,7 @@ void FJsEnvImpl::SetInterval(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FJsEnvImpl::MakeUClass(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope Isolatescope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -4295,6 +5066,7 @@ void FJsEnvImpl::MakeUClass(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FJsEnvImpl::Mixin(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
     CHECK_V8_ARGS(EArgObject, EArgObject);
@@ -21,7 +21,9 @@
 #endif
 #include "UECompatible.h"
 #include "ContainerMeta.h"
+#include "ContainerWrapper.h"
 #include "ObjectCacheNode.h"
+#include "Containers/Queue.h"
 #include <unordered_map>
 
 #if ENGINE_MINOR_VERSION >= 25 || ENGINE_MAJOR_VERSION > 4
@@ -38,6 +40,10 @@ PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 #include "NamespaceDef.h"
 
 #include "V8InspectorImpl.h"
+#include "CpuProfileRecorder.h"
+#include "IdleGCScheduler.h"
+#include "HeapLimitGuard.h"
+#include "RuntimeCodeCache.h"
 
 #if defined(WITH_NODEJS)
 PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
@@ -92,10 +98,18 @@ public:
 
     virtual void LowMemoryNotification() override;
 
+    virtual bool OnFrameIdle(double IdleBudgetInSeconds) override;
+
+    virtual FString GetGCPauseReport() override;
+
     virtual void RequestMinorGarbageCollectionForTesting() override;
 
     virtual void RequestFullGarbageCollectionForTesting() override;
 
+    virtual bool StartCpuProfiling(const FString& Title, int32 SamplingIntervalUs) override;
+
+    virtual bool StopCpuProfiling(const FString& Title, const FString& OutputPath) override;
+
     virtual void WaitDebugger(double timeout) override
     {
 #ifdef THREAD_SAFE
@@ -183,6 +197,8 @@ public:
 
     virtual void UnBindContainer(void* Ptr) override;
 
+    virtual FScriptArrayHashIndex* AddArrayHashIndex(FScriptArray* Ptr) override;
+
     virtual v8::Local<v8::Value> FindOrAddContainer(v8::Isolate* Isolate, v8::Local<v8::Context>& Context, PropertyMacro* Property,
         FScriptArray* Ptr, bool PassByPointer) override;
 
@@ -205,6 +221,12 @@ public:
 
     void ReleaseManualReleaseDelegate(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+#if !defined(WITH_QUICKJS)
+    void PostGroupMessage(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    void SetGroupMessageHandler(const v8::FunctionCallbackInfo<v8::Value>& Info);
+#endif
+
     virtual bool RemoveFromDelegate(
         v8::Isolate* Isolate, v8::Local<v8::Context>& Context, void* DelegatePtr, v8::Local<v8::Function> JsFunction) override;
 
@@ -222,8 +244,23 @@ public:
     virtual v8::Local<v8::Value> AddSoftObjectPtr(v8::Isolate* Isolate, v8::Local<v8::Context> Context,
         FSoftObjectPtr* SoftObjectPtr, UClass* Class, bool IsSoftClass) override;
 
+#if !defined(WITH_QUICKJS)
+    virtual v8::Local<v8::Value> LoadSoftObjectAsync(v8::Isolate* Isolate, v8::Local<v8::Context> Context,
+        const FSoftObjectPath& Path, UClass* PropertyClass, UClass* MetaClass) override;
+#endif
+
+    bool ResolveSoftObjectLoads(float Tick);
+
+    void ScheduleDelegateCleanup(void* DelegatePtr);
+
+    void RemoveDelegateFromOwner(void* DelegatePtr, const TWeakObjectPtr<UObject>& Owner);
+
     bool CheckDelegateProxies(float Tick);
 
+    bool CheckHeapLimit(float Tick);
+
+    bool FlushRuntimeCodeCache(float Tick);
+
     virtual v8::Local<v8::Value> CreateArray(
         v8::Isolate* Isolate, v8::Local<v8::Context>& Context, FPropertyTranslator* Property, void* ArrayPtr) override;
 
@@ -268,6 +305,9 @@ private:
     bool LoadFile(const FString& RequiringDir, const FString& ModuleName, FString& OutPath, FString& OutDebugPath,
         TArray<uint8>& Data, FString& ErrInfo);
 
+    // 读取模块源码，尽量以外部字符串的形式交给V8，WrapAsCommonJS为true时按CommonJS模块包装
+    v8::MaybeLocal<v8::String> LoadModuleSource(v8::Isolate* Isolate, const FString& Path, bool WrapAsCommonJS);
+
     void ExecuteModule(const FString& ModuleName);
 
     void EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info);
@@ -278,6 +318,13 @@ private:
 
     void LoadModule(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    void AddModuleImport(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    void RecordModuleImport(const FString& ImporterPath, const FString& ImportedPath);
+
+    // 返回被修改的模块以及所有直接、间接import它的模块,被修改的模块排在第一个
+    TArray<FString> CollectAffectedModules(const FString& ChangedKey);
+
     v8::Local<v8::Value> UETypeToJsClass(v8::Isolate* Isolate, v8::Local<v8::Context> Context, UField* Type);
 
     void LoadUEType(const v8::FunctionCallbackInfo<v8::Value>& Info);
@@ -489,6 +536,30 @@ public:
 
     TSharedPtr<IDynamicInvoker, ESPMode::ThreadSafe> MixinInvoker;
 #endif
+
+#if !defined(WITH_QUICKJS)
+    // JsEnvGroup内虚拟机之间的消息，Data为ValueSerializer序列化结果（结构化克隆），宿主直接发的字符串放Text
+    struct FGroupMessage
+    {
+        int32 Sender;
+        TArray<uint8> Data;
+        FString Text;
+    };
+
+    typedef std::function<bool(int32 Target, FGroupMessage&& Message)> FGroupMessageRouter;
+
+    // 需在脚本运行前调用，之后GroupMessageRouter会被多个线程读取
+    void InitGroupMessaging(int32 InGroupIndex, FGroupMessageRouter InRouter);
+
+    // 关闭后由JsEnvGroup的工作线程调用DispatchGroupMessages
+    void SetGroupMessageDispatchOnTicker(bool Enable);
+
+    // 可在任意线程调用
+    void EnqueueGroupMessage(FGroupMessage&& Message);
+
+    bool DispatchGroupMessages(float Tick);
+#endif
+
 private:
     FObjectRetainer UserObjectRetainer;
 
@@ -549,6 +620,18 @@ private:
 
     v8::Global<v8::Function> ReloadJs;
 
+    v8::Global<v8::Function> ReloadGraphJs;
+
+    // 模块依赖图,key为规范化后的全路径,记录被哪些模块import,热重载时只重新执行修改的模块和它的importer
+    struct FModuleGraphNode
+    {
+        // ModuleLoader给出的路径,js侧moduleCache用它做key
+        FString ModulePath;
+        TSet<FString> Importers;
+    };
+
+    TMap<FString, FModuleGraphNode> ModuleGraph;
+
 #if !PUERTS_FORCE_CPP_UFUNCTION
     v8::Global<v8::Function> MergePrototype;
 #endif
@@ -557,10 +640,6 @@ private:
 
     v8::Global<v8::Function> GenListApply;
 
-#if defined(WITH_V8_BYTECODE)
-    v8::Global<v8::Function> GenEmptyCode;
-#endif
-
     TMap<UStruct*, FTemplateInfo> TypeToTemplateInfoMap;
 
     TMap<FString, std::shared_ptr<FStructWrapper>> TypeReflectionMap;
@@ -574,6 +653,7 @@ private:
         v8::UniquePersistent<v8::Value> Container;
         bool NeedRelease;
         ContainerType Type;
+        std::unique_ptr<FScriptArrayHashIndex> ArrayHashIndex;
     };
 
     TMap<void*, ContainerCacheItem> ContainerCache;
@@ -614,6 +694,7 @@ private:
         bool PassByPointer;
         TWeakObjectPtr<UDynamicDelegateProxy> Proxy;
         v8::UniquePersistent<v8::Array> JsCallbacks;
+        bool CleanupScheduled = false;    //已在DelegateCleanupCandidates中
     };
 
     struct TsFunctionInfo
@@ -686,6 +767,12 @@ private:
 
     std::map<void*, DelegateObjectInfo> DelegateMap;
 
+    // Owner -> 挂在它身上的delegate，Owner被删除时只把这些delegate加入待清理列表，不再定时遍历整个DelegateMap
+    // 条目在Owner删除时整体移除，DelegateMap中删除delegate时同步从这里移除
+    TMap<const UObjectBase*, TSet<void*>> DelegatesByOwner;
+
+    std::vector<void*> DelegateCleanupCandidates;
+
     TMap<UFunction*, TsFunctionInfo> TsFunctionMap;
 
     TMap<UFunction*, v8::UniquePersistent<v8::Function>> MixinFunctionMap;
@@ -710,6 +797,49 @@ private:
 
     v8::Global<v8::Function> InspectorMessageHandler;
 
+    std::unique_ptr<ICpuProfileRecorder> CpuProfileRecorder;
+
+    std::unique_ptr<FIdleGCScheduler> IdleGCScheduler;
+
+    FUETickDelegateHandle HeapLimitCheckerHandler;
+
+    std::unique_ptr<FHeapLimitGuard> HeapLimitGuard;
+
+    FUETickDelegateHandle RuntimeCodeCacheHandler;
+
+#if !defined(WITH_QUICKJS)
+    struct FSoftObjectLoadWaiter
+    {
+        v8::Global<v8::Promise::Resolver> Resolver;
+        TWeakObjectPtr<UClass> PropertyClass;
+        TWeakObjectPtr<UClass> MetaClass;
+    };
+
+    // 同一路径的请求合并成一次异步加载
+    TMap<FSoftObjectPath, TArray<FSoftObjectLoadWaiter>> PendingSoftObjectLoads;
+
+    // 加载完成的路径，每帧统一resolve
+    TArray<FSoftObjectPath> CompletedSoftObjectLoads;
+#endif
+
+    FUETickDelegateHandle SoftObjectLoadHandler;
+
+#if !defined(WITH_QUICKJS)
+    int32 GroupIndex = -1;
+
+    FGroupMessageRouter GroupMessageRouter;
+
+    TQueue<FGroupMessage, EQueueMode::Mpsc> GroupMessageInbox;
+
+    v8::Global<v8::Function> GroupMessageHandler;
+#endif
+
+    FUETickDelegateHandle GroupMessageTickerHandler;
+
+#if !defined(WITH_QUICKJS)
+    std::unique_ptr<FRuntimeCodeCache> RuntimeCodeCache;
+#endif
+
     FContainerMeta ContainerMeta;
 
     v8::Global<v8::Map> ManualReleaseCallbackMap;
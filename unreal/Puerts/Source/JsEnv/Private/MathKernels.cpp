@@ -0,0 +1,722 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+// 批量数学运算，js侧用require('math_kernels')获取
+// 向量以SoA方式传入（x、y、z各一个数组），四元数以AoS方式传入（xyzw紧密排列），
+// 同一次调用的数组必须同为Float32Array或Float64Array，Float32Array在支持SSE2的平台上走SIMD路径
+
+#include "JSClassRegister.h"
+#include "DataTransfer.h"
+#include "V8Utils.h"
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PUERTS_MATH_KERNELS_SSE 1
+#include <emmintrin.h>
+#else
+#define PUERTS_MATH_KERNELS_SSE 0
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+namespace MathKernels
+{
+// 长度平方小于该值的向量归一化结果为0
+static const double NormalizeTolerance = 1e-8;
+
+// 标量实现，也用于SIMD路径处理不足4个的尾部元素
+template <typename T>
+static void Add(T* Out, const T* A, const T* B, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        Out[i] = A[i] + B[i];
+    }
+}
+
+template <typename T>
+static void Sub(T* Out, const T* A, const T* B, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        Out[i] = A[i] - B[i];
+    }
+}
+
+template <typename T>
+static void Scale(T* Out, const T* A, T S, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        Out[i] = A[i] * S;
+    }
+}
+
+template <typename T>
+static void ScaleAdd(T* Out, const T* A, const T* B, T S, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        Out[i] = A[i] + B[i] * S;
+    }
+}
+
+template <typename T>
+static void Dot3(T* Out, const T* AX, const T* AY, const T* AZ, const T* BX, const T* BY, const T* BZ, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        Out[i] = AX[i] * BX[i] + AY[i] * BY[i] + AZ[i] * BZ[i];
+    }
+}
+
+template <typename T>
+static void Cross3(T* OX, T* OY, T* OZ, const T* AX, const T* AY, const T* AZ, const T* BX, const T* BY, const T* BZ,
+    size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        // 先读后写，输出可以和输入是同一组数组
+        const T X = AY[i] * BZ[i] - AZ[i] * BY[i];
+        const T Y = AZ[i] * BX[i] - AX[i] * BZ[i];
+        const T Z = AX[i] * BY[i] - AY[i] * BX[i];
+        OX[i] = X;
+        OY[i] = Y;
+        OZ[i] = Z;
+    }
+}
+
+template <typename T>
+static void Length3(T* Out, const T* X, const T* Y, const T* Z, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        Out[i] = std::sqrt(X[i] * X[i] + Y[i] * Y[i] + Z[i] * Z[i]);
+    }
+}
+
+template <typename T>
+static void Normalize3(T* OX, T* OY, T* OZ, const T* X, const T* Y, const T* Z, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        const T LengthSquared = X[i] * X[i] + Y[i] * Y[i] + Z[i] * Z[i];
+        const T Scale = LengthSquared > static_cast<T>(NormalizeTolerance) ? 1 / std::sqrt(LengthSquared) : 0;
+        OX[i] = X[i] * Scale;
+        OY[i] = Y[i] * Scale;
+        OZ[i] = Z[i] * Scale;
+    }
+}
+
+template <typename T>
+static void Distance3(T* Out, const T* X, const T* Y, const T* Z, T PX, T PY, T PZ, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        const T DX = X[i] - PX;
+        const T DY = Y[i] - PY;
+        const T DZ = Z[i] - PZ;
+        Out[i] = std::sqrt(DX * DX + DY * DY + DZ * DZ);
+    }
+}
+
+// 返回命中总数，超出OutIndices容量的部分只计数不写入
+template <typename T>
+static size_t QueryRadius3(int32_t* OutIndices, size_t Capacity, size_t Hits, const T* X, const T* Y, const T* Z, T PX, T PY,
+    T PZ, T Radius, size_t Begin, size_t N)
+{
+    const T RadiusSquared = Radius * Radius;
+    for (size_t i = Begin; i < N; ++i)
+    {
+        const T DX = X[i] - PX;
+        const T DY = Y[i] - PY;
+        const T DZ = Z[i] - PZ;
+        if (DX * DX + DY * DY + DZ * DZ <= RadiusSquared)
+        {
+            if (Hits < Capacity)
+            {
+                OutIndices[Hits] = static_cast<int32_t>(i);
+            }
+            ++Hits;
+        }
+    }
+    return Hits;
+}
+
+// M为按行存储的4x4矩阵，和FMatrix::TransformPosition一致：行向量左乘，平移在第4行
+template <typename T>
+static void TransformPosition3(
+    T* OX, T* OY, T* OZ, const T* X, const T* Y, const T* Z, const T* M, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        const T PX = X[i];
+        const T PY = Y[i];
+        const T PZ = Z[i];
+        OX[i] = PX * M[0] + PY * M[4] + PZ * M[8] + M[12];
+        OY[i] = PX * M[1] + PY * M[5] + PZ * M[9] + M[13];
+        OZ[i] = PX * M[2] + PY * M[6] + PZ * M[10] + M[14];
+    }
+}
+
+// 和FQuat的A * B一致：先应用B的旋转再应用A的旋转
+template <typename T>
+static void QuatMul(T* Out, const T* A, const T* B, size_t Begin, size_t N)
+{
+    for (size_t i = Begin; i < N; ++i)
+    {
+        const T* QA = A + i * 4;
+        const T* QB = B + i * 4;
+        const T X = QA[3] * QB[0] + QA[0] * QB[3] + QA[1] * QB[2] - QA[2] * QB[1];
+        const T Y = QA[3] * QB[1] - QA[0] * QB[2] + QA[1] * QB[3] + QA[2] * QB[0];
+        const T Z = QA[3] * QB[2] + QA[0] * QB[1] - QA[1] * QB[0] + QA[2] * QB[3];
+        const T W = QA[3] * QB[3] - QA[0] * QB[0] - QA[1] * QB[1] - QA[2] * QB[2];
+        T* QO = Out + i * 4;
+        QO[0] = X;
+        QO[1] = Y;
+        QO[2] = Z;
+        QO[3] = W;
+    }
+}
+
+template <typename T>
+static void Add(T* Out, const T* A, const T* B, size_t N)
+{
+    Add(Out, A, B, 0, N);
+}
+
+template <typename T>
+static void Sub(T* Out, const T* A, const T* B, size_t N)
+{
+    Sub(Out, A, B, 0, N);
+}
+
+template <typename T>
+static void Scale(T* Out, const T* A, T S, size_t N)
+{
+    Scale(Out, A, S, 0, N);
+}
+
+template <typename T>
+static void ScaleAdd(T* Out, const T* A, const T* B, T S, size_t N)
+{
+    ScaleAdd(Out, A, B, S, 0, N);
+}
+
+template <typename T>
+static void Dot3(T* Out, const T* AX, const T* AY, const T* AZ, const T* BX, const T* BY, const T* BZ, size_t N)
+{
+    Dot3(Out, AX, AY, AZ, BX, BY, BZ, 0, N);
+}
+
+template <typename T>
+static void Cross3(T* OX, T* OY, T* OZ, const T* AX, const T* AY, const T* AZ, const T* BX, const T* BY, const T* BZ, size_t N)
+{
+    Cross3(OX, OY, OZ, AX, AY, AZ, BX, BY, BZ, 0, N);
+}
+
+template <typename T>
+static void Length3(T* Out, const T* X, const T* Y, const T* Z, size_t N)
+{
+    Length3(Out, X, Y, Z, 0, N);
+}
+
+template <typename T>
+static void Normalize3(T* OX, T* OY, T* OZ, const T* X, const T* Y, const T* Z, size_t N)
+{
+    Normalize3(OX, OY, OZ, X, Y, Z, 0, N);
+}
+
+template <typename T>
+static void Distance3(T* Out, const T* X, const T* Y, const T* Z, T PX, T PY, T PZ, size_t N)
+{
+    Distance3(Out, X, Y, Z, PX, PY, PZ, 0, N);
+}
+
+template <typename T>
+static size_t QueryRadius3(
+    int32_t* OutIndices, size_t Capacity, const T* X, const T* Y, const T* Z, T PX, T PY, T PZ, T Radius, size_t N)
+{
+    return QueryRadius3(OutIndices, Capacity, 0, X, Y, Z, PX, PY, PZ, Radius, 0, N);
+}
+
+template <typename T>
+static void TransformPosition3(T* OX, T* OY, T* OZ, const T* X, const T* Y, const T* Z, const T* M, size_t N)
+{
+    TransformPosition3(OX, OY, OZ, X, Y, Z, M, 0, N);
+}
+
+template <typename T>
+static void QuatMul(T* Out, const T* A, const T* B, size_t N)
+{
+    QuatMul(Out, A, B, 0, N);
+}
+
+#if PUERTS_MATH_KERNELS_SSE
+// Float32的SSE实现，每次处理4个元素，尾部交给标量实现；一律使用非对齐读写
+static void Add(float* Out, const float* A, const float* B, size_t N)
+{
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        _mm_storeu_ps(Out + i, _mm_add_ps(_mm_loadu_ps(A + i), _mm_loadu_ps(B + i)));
+    }
+    Add(Out, A, B, i, N);
+}
+
+static void Sub(float* Out, const float* A, const float* B, size_t N)
+{
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        _mm_storeu_ps(Out + i, _mm_sub_ps(_mm_loadu_ps(A + i), _mm_loadu_ps(B + i)));
+    }
+    Sub(Out, A, B, i, N);
+}
+
+static void Scale(float* Out, const float* A, float S, size_t N)
+{
+    const __m128 VS = _mm_set1_ps(S);
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        _mm_storeu_ps(Out + i, _mm_mul_ps(_mm_loadu_ps(A + i), VS));
+    }
+    Scale(Out, A, S, i, N);
+}
+
+static void ScaleAdd(float* Out, const float* A, const float* B, float S, size_t N)
+{
+    const __m128 VS = _mm_set1_ps(S);
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        _mm_storeu_ps(Out + i, _mm_add_ps(_mm_loadu_ps(A + i), _mm_mul_ps(_mm_loadu_ps(B + i), VS)));
+    }
+    ScaleAdd(Out, A, B, S, i, N);
+}
+
+static inline __m128 Dot3x4(__m128 AX, __m128 AY, __m128 AZ, __m128 BX, __m128 BY, __m128 BZ)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(AX, BX), _mm_mul_ps(AY, BY)), _mm_mul_ps(AZ, BZ));
+}
+
+static void Dot3(
+    float* Out, const float* AX, const float* AY, const float* AZ, const float* BX, const float* BY, const float* BZ, size_t N)
+{
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        _mm_storeu_ps(Out + i, Dot3x4(_mm_loadu_ps(AX + i), _mm_loadu_ps(AY + i), _mm_loadu_ps(AZ + i), _mm_loadu_ps(BX + i),
+                                   _mm_loadu_ps(BY + i), _mm_loadu_ps(BZ + i)));
+    }
+    Dot3(Out, AX, AY, AZ, BX, BY, BZ, i, N);
+}
+
+static void Cross3(float* OX, float* OY, float* OZ, const float* AX, const float* AY, const float* AZ, const float* BX,
+    const float* BY, const float* BZ, size_t N)
+{
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        const __m128 VAX = _mm_loadu_ps(AX + i);
+        const __m128 VAY = _mm_loadu_ps(AY + i);
+        const __m128 VAZ = _mm_loadu_ps(AZ + i);
+        const __m128 VBX = _mm_loadu_ps(BX + i);
+        const __m128 VBY = _mm_loadu_ps(BY + i);
+        const __m128 VBZ = _mm_loadu_ps(BZ + i);
+        _mm_storeu_ps(OX + i, _mm_sub_ps(_mm_mul_ps(VAY, VBZ), _mm_mul_ps(VAZ, VBY)));
+        _mm_storeu_ps(OY + i, _mm_sub_ps(_mm_mul_ps(VAZ, VBX), _mm_mul_ps(VAX, VBZ)));
+        _mm_storeu_ps(OZ + i, _mm_sub_ps(_mm_mul_ps(VAX, VBY), _mm_mul_ps(VAY, VBX)));
+    }
+    Cross3(OX, OY, OZ, AX, AY, AZ, BX, BY, BZ, i, N);
+}
+
+static void Length3(float* Out, const float* X, const float* Y, const float* Z, size_t N)
+{
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        const __m128 VX = _mm_loadu_ps(X + i);
+        const __m128 VY = _mm_loadu_ps(Y + i);
+        const __m128 VZ = _mm_loadu_ps(Z + i);
+        _mm_storeu_ps(Out + i, _mm_sqrt_ps(Dot3x4(VX, VY, VZ, VX, VY, VZ)));
+    }
+    Length3(Out, X, Y, Z, i, N);
+}
+
+static void Normalize3(float* OX, float* OY, float* OZ, const float* X, const float* Y, const float* Z, size_t N)
+{
+    const __m128 Tolerance = _mm_set1_ps(static_cast<float>(NormalizeTolerance));
+    const __m128 One = _mm_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        const __m128 VX = _mm_loadu_ps(X + i);
+        const __m128 VY = _mm_loadu_ps(Y + i);
+        const __m128 VZ = _mm_loadu_ps(Z + i);
+        const __m128 LengthSquared = Dot3x4(VX, VY, VZ, VX, VY, VZ);
+        // 用精确的sqrt和除法而不是rsqrt近似，和标量路径结果一致
+        const __m128 Scale =
+            _mm_and_ps(_mm_cmpgt_ps(LengthSquared, Tolerance), _mm_div_ps(One, _mm_sqrt_ps(LengthSquared)));
+        _mm_storeu_ps(OX + i, _mm_mul_ps(VX, Scale));
+        _mm_storeu_ps(OY + i, _mm_mul_ps(VY, Scale));
+        _mm_storeu_ps(OZ + i, _mm_mul_ps(VZ, Scale));
+    }
+    Normalize3(OX, OY, OZ, X, Y, Z, i, N);
+}
+
+static void Distance3(float* Out, const float* X, const float* Y, const float* Z, float PX, float PY, float PZ, size_t N)
+{
+    const __m128 VPX = _mm_set1_ps(PX);
+    const __m128 VPY = _mm_set1_ps(PY);
+    const __m128 VPZ = _mm_set1_ps(PZ);
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        const __m128 DX = _mm_sub_ps(_mm_loadu_ps(X + i), VPX);
+        const __m128 DY = _mm_sub_ps(_mm_loadu_ps(Y + i), VPY);
+        const __m128 DZ = _mm_sub_ps(_mm_loadu_ps(Z + i), VPZ);
+        _mm_storeu_ps(Out + i, _mm_sqrt_ps(Dot3x4(DX, DY, DZ, DX, DY, DZ)));
+    }
+    Distance3(Out, X, Y, Z, PX, PY, PZ, i, N);
+}
+
+static size_t QueryRadius3(int32_t* OutIndices, size_t Capacity, const float* X, const float* Y, const float* Z, float PX,
+    float PY, float PZ, float Radius, size_t N)
+{
+    const __m128 VPX = _mm_set1_ps(PX);
+    const __m128 VPY = _mm_set1_ps(PY);
+    const __m128 VPZ = _mm_set1_ps(PZ);
+    const __m128 RadiusSquared = _mm_set1_ps(Radius * Radius);
+    size_t Hits = 0;
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        const __m128 DX = _mm_sub_ps(_mm_loadu_ps(X + i), VPX);
+        const __m128 DY = _mm_sub_ps(_mm_loadu_ps(Y + i), VPY);
+        const __m128 DZ = _mm_sub_ps(_mm_loadu_ps(Z + i), VPZ);
+        int Mask = _mm_movemask_ps(_mm_cmple_ps(Dot3x4(DX, DY, DZ, DX, DY, DZ), RadiusSquared));
+        for (int Lane = 0; Mask != 0; ++Lane, Mask >>= 1)
+        {
+            if (Mask & 1)
+            {
+                if (Hits < Capacity)
+                {
+                    OutIndices[Hits] = static_cast<int32_t>(i + Lane);
+                }
+                ++Hits;
+            }
+        }
+    }
+    return QueryRadius3(OutIndices, Capacity, Hits, X, Y, Z, PX, PY, PZ, Radius, i, N);
+}
+
+static void TransformPosition3(
+    float* OX, float* OY, float* OZ, const float* X, const float* Y, const float* Z, const float* M, size_t N)
+{
+    __m128 VM[12];
+    for (int j = 0; j < 12; ++j)
+    {
+        // 只用到前三列，第四列跳过
+        VM[j] = _mm_set1_ps(M[(j / 3) * 4 + j % 3]);
+    }
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4)
+    {
+        const __m128 VX = _mm_loadu_ps(X + i);
+        const __m128 VY = _mm_loadu_ps(Y + i);
+        const __m128 VZ = _mm_loadu_ps(Z + i);
+        for (int Col = 0; Col < 3; ++Col)
+        {
+            const __m128 R = _mm_add_ps(_mm_add_ps(_mm_mul_ps(VX, VM[Col]), _mm_mul_ps(VY, VM[3 + Col])),
+                _mm_add_ps(_mm_mul_ps(VZ, VM[6 + Col]), VM[9 + Col]));
+            _mm_storeu_ps((Col == 0 ? OX : (Col == 1 ? OY : OZ)) + i, R);
+        }
+    }
+    TransformPosition3(OX, OY, OZ, X, Y, Z, M, i, N);
+}
+
+static void QuatMul(float* Out, const float* A, const float* B, size_t N)
+{
+    // 按A的分量展开：R = aw * B + ax * (bw, -bz, by, -bx) + ay * (bz, bw, -bx, -by) + az * (-by, bx, bw, -bz)
+    const __m128 SignX = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+    const __m128 SignY = _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f);
+    const __m128 SignZ = _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f);
+    for (size_t i = 0; i < N; ++i)
+    {
+        const __m128 QA = _mm_loadu_ps(A + i * 4);
+        const __m128 QB = _mm_loadu_ps(B + i * 4);
+        __m128 R = _mm_mul_ps(_mm_shuffle_ps(QA, QA, _MM_SHUFFLE(3, 3, 3, 3)), QB);
+        R = _mm_add_ps(R, _mm_mul_ps(_mm_mul_ps(_mm_shuffle_ps(QA, QA, _MM_SHUFFLE(0, 0, 0, 0)),
+                                         _mm_shuffle_ps(QB, QB, _MM_SHUFFLE(0, 1, 2, 3))),
+                              SignX));
+        R = _mm_add_ps(R, _mm_mul_ps(_mm_mul_ps(_mm_shuffle_ps(QA, QA, _MM_SHUFFLE(1, 1, 1, 1)),
+                                         _mm_shuffle_ps(QB, QB, _MM_SHUFFLE(1, 0, 3, 2))),
+                              SignY));
+        R = _mm_add_ps(R, _mm_mul_ps(_mm_mul_ps(_mm_shuffle_ps(QA, QA, _MM_SHUFFLE(2, 2, 2, 2)),
+                                         _mm_shuffle_ps(QB, QB, _MM_SHUFFLE(2, 3, 0, 1))),
+                              SignZ));
+        _mm_storeu_ps(Out + i * 4, R);
+    }
+}
+#endif
+}    // namespace MathKernels
+}    // namespace PUERTS_NAMESPACE
+
+namespace
+{
+enum class EElementType
+{
+    None,
+    Float32,
+    Float64
+};
+
+EElementType GetElementType(v8::Local<v8::Value> Value)
+{
+    if (Value->IsFloat32Array())
+    {
+        return EElementType::Float32;
+    }
+    if (Value->IsFloat64Array())
+    {
+        return EElementType::Float64;
+    }
+    return EElementType::None;
+}
+
+template <typename T>
+T* GetArrayData(v8::Local<v8::Value> Value)
+{
+    auto View = Value.As<v8::ArrayBufferView>();
+    return reinterpret_cast<T*>(
+        static_cast<char*>(PUERTS_NAMESPACE::DataTransfer::GetArrayBufferData(View->Buffer())) + View->ByteOffset());
+}
+
+size_t GetArrayLength(v8::Local<v8::Value> Value)
+{
+    return Value.As<v8::TypedArray>()->Length();
+}
+
+template <typename T>
+T GetNumber(const v8::FunctionCallbackInfo<v8::Value>& Info, int Index)
+{
+    return static_cast<T>(Info[Index].As<v8::Number>()->Value());
+}
+
+// 前ArrayCount个参数须为类型相同、长度相同的浮点数组，其后NumberCount个参数须为数字
+EElementType CheckKernelArgs(const v8::FunctionCallbackInfo<v8::Value>& Info, int ArrayCount, int NumberCount)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    if (Info.Length() < ArrayCount + NumberCount)
+    {
+        PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "Bad parameters, not enough arguments.");
+        return EElementType::None;
+    }
+    const EElementType ElementType = GetElementType(Info[0]);
+    if (ElementType == EElementType::None)
+    {
+        PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "Bad parameters, expect Float32Array or Float64Array.");
+        return EElementType::None;
+    }
+    const size_t Length = GetArrayLength(Info[0]);
+    for (int i = 1; i < ArrayCount; ++i)
+    {
+        if (GetElementType(Info[i]) != ElementType || GetArrayLength(Info[i]) != Length)
+        {
+            PUERTS_NAMESPACE::FV8Utils::ThrowException(
+                Isolate, "Bad parameters, all arrays must have the same element type and length.");
+            return EElementType::None;
+        }
+    }
+    for (int i = ArrayCount; i < ArrayCount + NumberCount; ++i)
+    {
+        if (!Info[i]->IsNumber())
+        {
+            PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "Bad parameters, expect a number.");
+            return EElementType::None;
+        }
+    }
+    return ElementType;
+}
+
+template <typename T>
+void AddImpl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    PUERTS_NAMESPACE::MathKernels::Add(
+        GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]), GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void SubImpl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    PUERTS_NAMESPACE::MathKernels::Sub(
+        GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]), GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void ScaleImpl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    PUERTS_NAMESPACE::MathKernels::Scale(
+        GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetNumber<T>(Info, 2), GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void ScaleAddImpl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    PUERTS_NAMESPACE::MathKernels::ScaleAdd(GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]),
+        GetNumber<T>(Info, 3), GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void Dot3Impl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    PUERTS_NAMESPACE::MathKernels::Dot3(GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]),
+        GetArrayData<T>(Info[3]), GetArrayData<T>(Info[4]), GetArrayData<T>(Info[5]), GetArrayData<T>(Info[6]),
+        GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void Cross3Impl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    PUERTS_NAMESPACE::MathKernels::Cross3(GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]),
+        GetArrayData<T>(Info[3]), GetArrayData<T>(Info[4]), GetArrayData<T>(Info[5]), GetArrayData<T>(Info[6]),
+        GetArrayData<T>(Info[7]), GetArrayData<T>(Info[8]), GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void Length3Impl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    PUERTS_NAMESPACE::MathKernels::Length3(GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]),
+        GetArrayData<T>(Info[3]), GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void Normalize3Impl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    PUERTS_NAMESPACE::MathKernels::Normalize3(GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]),
+        GetArrayData<T>(Info[3]), GetArrayData<T>(Info[4]), GetArrayData<T>(Info[5]), GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void Distance3Impl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    PUERTS_NAMESPACE::MathKernels::Distance3(GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]),
+        GetArrayData<T>(Info[3]), GetNumber<T>(Info, 4), GetNumber<T>(Info, 5), GetNumber<T>(Info, 6), GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void QueryRadius3Impl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    if (Info.Length() < 8 || !Info[7]->IsInt32Array())
+    {
+        PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "Bad parameters #7, expect an Int32Array.");
+        return;
+    }
+    const size_t Hits = PUERTS_NAMESPACE::MathKernels::QueryRadius3(GetArrayData<int32_t>(Info[7]), GetArrayLength(Info[7]),
+        GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]), GetNumber<T>(Info, 3),
+        GetNumber<T>(Info, 4), GetNumber<T>(Info, 5), GetNumber<T>(Info, 6), GetArrayLength(Info[0]));
+    Info.GetReturnValue().Set(static_cast<double>(Hits));
+}
+
+template <typename T>
+void TransformPosition3Impl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    if (Info.Length() < 7 || GetElementType(Info[6]) != GetElementType(Info[0]) || GetArrayLength(Info[6]) < 16)
+    {
+        PUERTS_NAMESPACE::FV8Utils::ThrowException(Isolate, "Bad parameters #6, expect a 4x4 matrix of the same element type.");
+        return;
+    }
+    PUERTS_NAMESPACE::MathKernels::TransformPosition3(GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]),
+        GetArrayData<T>(Info[2]), GetArrayData<T>(Info[3]), GetArrayData<T>(Info[4]), GetArrayData<T>(Info[5]),
+        GetArrayData<T>(Info[6]), GetArrayLength(Info[0]));
+}
+
+template <typename T>
+void QuatMulImpl(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    const size_t Length = GetArrayLength(Info[0]);
+    if (Length % 4 != 0)
+    {
+        PUERTS_NAMESPACE::FV8Utils::ThrowException(
+            Info.GetIsolate(), "Bad parameters, quaternion array length must be a multiple of 4.");
+        return;
+    }
+    PUERTS_NAMESPACE::MathKernels::QuatMul(
+        GetArrayData<T>(Info[0]), GetArrayData<T>(Info[1]), GetArrayData<T>(Info[2]), Length / 4);
+}
+
+#define MATH_KERNEL_BINDING(Name, ArrayCount, NumberCount)                  \
+    void Name(const v8::FunctionCallbackInfo<v8::Value>& Info)              \
+    {                                                                       \
+        switch (CheckKernelArgs(Info, ArrayCount, NumberCount))             \
+        {                                                                   \
+            case EElementType::Float32:                                     \
+                Name##Impl<float>(Info);                                    \
+                break;                                                      \
+            case EElementType::Float64:                                     \
+                Name##Impl<double>(Info);                                   \
+                break;                                                      \
+            default:                                                        \
+                break;                                                      \
+        }                                                                   \
+    }
+
+MATH_KERNEL_BINDING(Add, 3, 0)
+MATH_KERNEL_BINDING(Sub, 3, 0)
+MATH_KERNEL_BINDING(Scale, 2, 1)
+MATH_KERNEL_BINDING(ScaleAdd, 3, 1)
+MATH_KERNEL_BINDING(Dot3, 7, 0)
+MATH_KERNEL_BINDING(Cross3, 9, 0)
+MATH_KERNEL_BINDING(Length3, 4, 0)
+MATH_KERNEL_BINDING(Normalize3, 6, 0)
+MATH_KERNEL_BINDING(Distance3, 4, 3)
+MATH_KERNEL_BINDING(QueryRadius3, 3, 4)
+MATH_KERNEL_BINDING(TransformPosition3, 6, 0)
+MATH_KERNEL_BINDING(QuatMul, 3, 0)
+
+#undef MATH_KERNEL_BINDING
+
+void Init(v8::Local<v8::Context> Context, v8::Local<v8::Object> Exports)
+{
+    v8::Isolate* Isolate = Context->GetIsolate();
+
+#define SET_KERNEL(Name, Func)                                                                     \
+    Exports                                                                                        \
+        ->Set(Context, PUERTS_NAMESPACE::FV8Utils::ToV8String(Isolate, Name),                      \
+            v8::FunctionTemplate::New(Isolate, Func)->GetFunction(Context).ToLocalChecked())       \
+        .Check()
+
+    SET_KERNEL("add", Add);
+    SET_KERNEL("sub", Sub);
+    SET_KERNEL("scale", Scale);
+    SET_KERNEL("scaleAdd", ScaleAdd);
+    SET_KERNEL("dot3", Dot3);
+    SET_KERNEL("cross3", Cross3);
+    SET_KERNEL("length3", Length3);
+    SET_KERNEL("normalize3", Normalize3);
+    SET_KERNEL("distance3", Distance3);
+    SET_KERNEL("queryRadius3", QueryRadius3);
+    SET_KERNEL("transformPosition3", TransformPosition3);
+    SET_KERNEL("quatMul", QuatMul);
+#undef SET_KERNEL
+
+    Exports
+        ->DefineOwnProperty(Context, PUERTS_NAMESPACE::FV8Utils::ToV8String(Isolate, "SIMD"),
+            v8::Boolean::New(Isolate, PUERTS_MATH_KERNELS_SSE != 0),
+            static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete))
+        .Check();
+}
+}    // namespace
+
+PUERTS_MODULE(math_kernels, Init);
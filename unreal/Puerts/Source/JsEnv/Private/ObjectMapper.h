@@ -27,6 +27,10 @@ PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 
 namespace PUERTS_NAMESPACE
 {
+#if USING_IN_UNREAL_ENGINE
+struct FScriptArrayHashIndex;
+#endif
+
 class ICppObjectMapper
 {
 public:
@@ -73,6 +77,9 @@ public:
 
     virtual void UnBindContainer(void* Ptr) = 0;
 
+    // 索引的生命周期与容器的js对象一致
+    virtual FScriptArrayHashIndex* AddArrayHashIndex(FScriptArray* Ptr) = 0;
+
     virtual v8::Local<v8::Value> FindOrAddContainer(
         v8::Isolate* Isolate, v8::Local<v8::Context>& Context, PropertyMacro* Property, FScriptArray* Ptr, bool PassByPointer) = 0;
 
@@ -108,6 +115,12 @@ public:
 
     virtual v8::Local<v8::Value> AddSoftObjectPtr(
         v8::Isolate* Isolate, v8::Local<v8::Context> Context, FSoftObjectPtr* SoftObjectPtr, UClass* Class, bool IsSoftClass) = 0;
+
+#if !defined(WITH_QUICKJS)
+    // 返回一个Promise，加载完成后在下一帧统一resolve，加载失败或类型不符时resolve为undefined
+    virtual v8::Local<v8::Value> LoadSoftObjectAsync(v8::Isolate* Isolate, v8::Local<v8::Context> Context,
+        const FSoftObjectPath& Path, UClass* PropertyClass, UClass* MetaClass) = 0;
+#endif
 };
 #endif
 
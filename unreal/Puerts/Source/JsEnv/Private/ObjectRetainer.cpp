@@ -7,6 +7,7 @@
  */
 
 #include "ObjectRetainer.h"
+#include "UObject/UObjectBase.h"
 #include "PuertsNamespaceDef.h"
 
 #ifdef THREAD_SAFE
@@ -22,37 +23,112 @@ namespace PUERTS_NAMESPACE
 void FObjectRetainer::Retain(UObject* Object)
 {
 #ifdef THREAD_SAFE
-    FScopeLock ScopeLock(&RetainedObjectsCritical);
-#endif
-    if (!RetainedObjects.Contains(Object))
+    if (!IsInGameThread())
     {
-        RetainedObjects.Add(Object);
+        PendingOperations.Enqueue({Object, true});
+        return;
     }
+    FlushPendingOperations();
+#endif
+    RetainInternal(Object);
 }
 
 void FObjectRetainer::Release(UObject* Object)
 {
 #ifdef THREAD_SAFE
-    FScopeLock ScopeLock(&RetainedObjectsCritical);
+    if (!IsInGameThread())
+    {
+        PendingOperations.Enqueue({Object, false});
+        return;
+    }
+    FlushPendingOperations();
 #endif
-    if (RetainedObjects.Contains(Object))
+    ReleaseInternal(Object);
+}
+
+void FObjectRetainer::RetainInternal(UObject* Object)
+{
+    if (!Object)
     {
-        RetainedObjects.Remove(Object);
+        return;
     }
+    const int32 ObjectIndex = Object->GetUniqueID();
+    if (ObjectIndex >= SlotByObjectIndex.Num())
+    {
+        SlotByObjectIndex.AddZeroed(FMath::Max(ObjectIndex + 1, SlotByObjectIndex.Num() * 2) - SlotByObjectIndex.Num());
+    }
+    const int32 Slot = SlotByObjectIndex[ObjectIndex] - 1;
+    if (Slot >= 0)
+    {
+        // the index may have been reused by a new object after the old one was destroyed without being released
+        RetainedObjects[Slot] = Object;
+        return;
+    }
+    RetainedObjects.Add(Object);
+    RetainedObjectIndices.Add(ObjectIndex);
+    SlotByObjectIndex[ObjectIndex] = RetainedObjects.Num();
 }
 
+void FObjectRetainer::ReleaseInternal(UObject* Object)
+{
+    if (!Object)
+    {
+        return;
+    }
+    const int32 ObjectIndex = Object->GetUniqueID();
+    if (ObjectIndex >= SlotByObjectIndex.Num())
+    {
+        return;
+    }
+    const int32 Slot = SlotByObjectIndex[ObjectIndex] - 1;
+    if (Slot < 0 || (RetainedObjects[Slot] && RetainedObjects[Slot] != Object))
+    {
+        return;
+    }
+    const int32 LastSlot = RetainedObjects.Num() - 1;
+    if (Slot != LastSlot)
+    {
+        RetainedObjects[Slot] = RetainedObjects[LastSlot];
+        RetainedObjectIndices[Slot] = RetainedObjectIndices[LastSlot];
+        SlotByObjectIndex[RetainedObjectIndices[Slot]] = Slot + 1;
+    }
+    RetainedObjects.Pop(false);
+    RetainedObjectIndices.Pop(false);
+    SlotByObjectIndex[ObjectIndex] = 0;
+}
+
+#ifdef THREAD_SAFE
+void FObjectRetainer::FlushPendingOperations()
+{
+    FPendingOperation Operation;
+    while (PendingOperations.Dequeue(Operation))
+    {
+        if (Operation.IsRetain)
+        {
+            RetainInternal(Operation.Object);
+        }
+        else
+        {
+            ReleaseInternal(Operation.Object);
+        }
+    }
+}
+#endif
+
 void FObjectRetainer::Clear()
 {
 #ifdef THREAD_SAFE
-    FScopeLock ScopeLock(&RetainedObjectsCritical);
+    PendingOperations.Empty();
 #endif
     RetainedObjects.Empty();
+    RetainedObjectIndices.Empty();
+    SlotByObjectIndex.Empty();
 }
 
 void FObjectRetainer::AddReferencedObjects(FReferenceCollector& Collector)
 {
 #ifdef THREAD_SAFE
-    FScopeLock ScopeLock(&RetainedObjectsCritical);
+    FlushPendingOperations();
 #endif
     Collector.AddReferencedObjects(RetainedObjects);
 }
@@ -22,51 +22,251 @@
 
 namespace PUERTS_NAMESPACE
 {
-void FPropertyTranslator::Getter(const v8::FunctionCallbackInfo<v8::Value>& Info)
-{
-    v8::Isolate* Isolate = Info.GetIsolate();
-    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
-
-    FPropertyTranslator* This = static_cast<FPropertyTranslator*>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
-    This->Getter(Isolate, Context, Info);
-}
+std::atomic<uint32> FPropertyTranslator::PropertyValidEpoch(1);
 
-void FPropertyTranslator::Getter(
-    v8::Isolate* Isolate, v8::Local<v8::Context>& Context, const v8::FunctionCallbackInfo<v8::Value>& Info)
+void FPropertyTranslator::InitFastAccess(PropertyMacro* InProperty)
 {
-    if (!IsPropertyValid())
+    FastAccessKind = EFastAccessKind::None;
+    Offset = InProperty->GetOffset_ForInternal();
+    if (InProperty->ArrayDim != 1 || (InProperty->PropertyFlags & CPF_Parm))
     {
-        FV8Utils::ThrowException(Isolate, "Property is invalid!");
         return;
     }
+    if (InProperty->IsA<IntPropertyMacro>())
+    {
+        FastAccessKind = EFastAccessKind::Int32;
+    }
+    else if (InProperty->IsA<BytePropertyMacro>())
+    {
+        FastAccessKind = EFastAccessKind::Byte;
+    }
+    else if (InProperty->IsA<FloatPropertyMacro>())
+    {
+        FastAccessKind = EFastAccessKind::Float;
+    }
+    else if (InProperty->IsA<DoublePropertyMacro>())
+    {
+        FastAccessKind = EFastAccessKind::Double;
+    }
+    else if (InProperty->IsA<BoolPropertyMacro>())
+    {
+        FastAccessKind = EFastAccessKind::Bool;
+    }
+    else if (InProperty->IsA<NamePropertyMacro>())
+    {
+        FastAccessKind = EFastAccessKind::Name;
+    }
+    else if (auto InEnumProperty = CastFieldMacro<EnumPropertyMacro>(InProperty))
+    {
+        auto UnderlyingProperty = InEnumProperty->GetUnderlyingProperty();
+        if (UnderlyingProperty->IsA<BytePropertyMacro>())
+        {
+            FastAccessKind = EFastAccessKind::Byte;
+        }
+        else if (UnderlyingProperty->IsA<IntPropertyMacro>())
+        {
+            FastAccessKind = EFastAccessKind::Int32;
+        }
+    }
+}
 
-    v8::Local<v8::Value> Ret;
-
+void* FPropertyTranslator::GetContainer(v8::Isolate* Isolate, v8::Local<v8::Object> Holder)
+{
     if (OwnerIsClass)
     {
-        UObject* Object = FV8Utils::GetUObject(Info.Holder());
+        UObject* Object = FV8Utils::GetUObject(Holder);
         if (!Object)
         {
             FV8Utils::ThrowException(Isolate, "access a null object");
-            return;
+            return nullptr;
         }
         if (FV8Utils::IsReleasedPtr(Object))
         {
             FV8Utils::ThrowException(Isolate, "access a invalid object");
-            return;
+            return nullptr;
         }
-        Ret = UEToJsInContainer(Isolate, Context, Object, true);
+        return Object;
     }
     else
     {
-        auto Ptr = FV8Utils::GetPointer(Info.Holder());
+        auto Ptr = FV8Utils::GetPointer(Holder);
         if (!Ptr)
         {
             FV8Utils::ThrowException(Isolate, "access a null struct");
+            return nullptr;
+        }
+        return Ptr;
+    }
+}
+
+struct FInt32FastAccess
+{
+    static constexpr EFastAccessKind Kind = EFastAccessKind::Int32;
+
+    static void Get(const v8::FunctionCallbackInfo<v8::Value>& Info, FPropertyTranslator* This, const uint8* ValuePtr)
+    {
+        Info.GetReturnValue().Set(*reinterpret_cast<const int32*>(ValuePtr));
+    }
+
+    static void Set(v8::Local<v8::Context>& Context, v8::Local<v8::Value> Value, FPropertyTranslator* This, uint8* ValuePtr)
+    {
+        *reinterpret_cast<int32*>(ValuePtr) = Value->Int32Value(Context).ToChecked();
+    }
+};
+
+struct FByteFastAccess
+{
+    static constexpr EFastAccessKind Kind = EFastAccessKind::Byte;
+
+    static void Get(const v8::FunctionCallbackInfo<v8::Value>& Info, FPropertyTranslator* This, const uint8* ValuePtr)
+    {
+        Info.GetReturnValue().Set(static_cast<int32>(*ValuePtr));
+    }
+
+    static void Set(v8::Local<v8::Context>& Context, v8::Local<v8::Value> Value, FPropertyTranslator* This, uint8* ValuePtr)
+    {
+        *ValuePtr = static_cast<uint8>(Value->Int32Value(Context).ToChecked());
+    }
+};
+
+struct FFloatFastAccess
+{
+    static constexpr EFastAccessKind Kind = EFastAccessKind::Float;
+
+    static void Get(const v8::FunctionCallbackInfo<v8::Value>& Info, FPropertyTranslator* This, const uint8* ValuePtr)
+    {
+        Info.GetReturnValue().Set(static_cast<double>(*reinterpret_cast<const float*>(ValuePtr)));
+    }
+
+    static void Set(v8::Local<v8::Context>& Context, v8::Local<v8::Value> Value, FPropertyTranslator* This, uint8* ValuePtr)
+    {
+        *reinterpret_cast<float*>(ValuePtr) = static_cast<float>(Value->NumberValue(Context).ToChecked());
+    }
+};
+
+struct FDoubleFastAccess
+{
+    static constexpr EFastAccessKind Kind = EFastAccessKind::Double;
+
+    static void Get(const v8::FunctionCallbackInfo<v8::Value>& Info, FPropertyTranslator* This, const uint8* ValuePtr)
+    {
+        Info.GetReturnValue().Set(*reinterpret_cast<const double*>(ValuePtr));
+    }
+
+    static void Set(v8::Local<v8::Context>& Context, v8::Local<v8::Value> Value, FPropertyTranslator* This, uint8* ValuePtr)
+    {
+        *reinterpret_cast<double*>(ValuePtr) = Value->NumberValue(Context).ToChecked();
+    }
+};
+
+// 位域bool按BoolProperty的字节偏移和掩码读写，普通bool的掩码是整个字节
+struct FBoolFastAccess
+{
+    static constexpr EFastAccessKind Kind = EFastAccessKind::Bool;
+
+    static void Get(const v8::FunctionCallbackInfo<v8::Value>& Info, FPropertyTranslator* This, const uint8* ValuePtr)
+    {
+        auto BoolProperty = This->BoolProperty;
+        Info.GetReturnValue().Set((ValuePtr[BoolProperty->GetByteOffset()] & BoolProperty->GetFieldMask()) != 0);
+    }
+
+    static void Set(v8::Local<v8::Context>& Context, v8::Local<v8::Value> Value, FPropertyTranslator* This, uint8* ValuePtr)
+    {
+        auto BoolProperty = This->BoolProperty;
+        uint8* BytePtr = ValuePtr + BoolProperty->GetByteOffset();
+        *BytePtr = (*BytePtr & ~BoolProperty->GetFieldMask()) |
+                   (Value->BooleanValue(Context->GetIsolate()) ? BoolProperty->GetByteMask() : 0);
+    }
+};
+
+struct FNameFastAccess
+{
+    static constexpr EFastAccessKind Kind = EFastAccessKind::Name;
+
+    static void Get(const v8::FunctionCallbackInfo<v8::Value>& Info, FPropertyTranslator* This, const uint8* ValuePtr)
+    {
+        Info.GetReturnValue().Set(FV8Utils::ToV8String(Info.GetIsolate(), *reinterpret_cast<const FName*>(ValuePtr)));
+    }
+
+    // 设置时还要处理ArrayBuffer传入的FName，走原来的转换
+    static void Set(v8::Local<v8::Context>& Context, v8::Local<v8::Value> Value, FPropertyTranslator* This, uint8* ValuePtr)
+    {
+        This->JsToUE(Context->GetIsolate(), Context, Value, ValuePtr, true);
+    }
+};
+
+// 模板创建时按属性类型选定，直接按偏移读写，省掉虚函数调用和通用转换
+template <typename Access>
+struct TFastPropertyAccessor
+{
+    static void Getter(const v8::FunctionCallbackInfo<v8::Value>& Info)
+    {
+        v8::Isolate* Isolate = Info.GetIsolate();
+        FPropertyTranslator* This = static_cast<FPropertyTranslator*>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
+        if (!This->IsPropertyValidCached())
+        {
+            FV8Utils::ThrowException(Isolate, "Property is invalid!");
             return;
         }
-        Ret = UEToJsInContainer(Isolate, Context, Ptr, true);
+        // 编辑器下属性可能被重新创建成别的类型，但模板还在用
+        if (This->FastAccessKind != Access::Kind)
+        {
+            FPropertyTranslator::Getter(Info);
+            return;
+        }
+        if (auto Container = This->GetContainer(Isolate, Info.Holder()))
+        {
+            Access::Get(Info, This, static_cast<const uint8*>(Container) + This->Offset);
+        }
+    }
+
+    static void Setter(const v8::FunctionCallbackInfo<v8::Value>& Info)
+    {
+        v8::Isolate* Isolate = Info.GetIsolate();
+        FPropertyTranslator* This = static_cast<FPropertyTranslator*>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
+        if (!This->IsPropertyValidCached())
+        {
+            FV8Utils::ThrowException(Isolate, "Property is invalid!");
+            return;
+        }
+        if (This->FastAccessKind != Access::Kind)
+        {
+            FPropertyTranslator::Setter(Info);
+            return;
+        }
+        if (auto Container = This->GetContainer(Isolate, Info.Holder()))
+        {
+            v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+            Access::Set(Context, Info[0], This, static_cast<uint8*>(Container) + This->Offset);
+        }
+    }
+};
+
+void FPropertyTranslator::Getter(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    FPropertyTranslator* This = static_cast<FPropertyTranslator*>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
+    This->Getter(Isolate, Context, Info);
+}
+
+void FPropertyTranslator::Getter(
+    v8::Isolate* Isolate, v8::Local<v8::Context>& Context, const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    if (!IsPropertyValidCached())
+    {
+        FV8Utils::ThrowException(Isolate, "Property is invalid!");
+        return;
+    }
+
+    auto Container = GetContainer(Isolate, Info.Holder());
+    if (!Container)
+    {
+        return;
     }
+    v8::Local<v8::Value> Ret = UEToJsInContainer(Isolate, Context, Container, true);
     if (NeedLinkOuter)
     {
         LinkOuterImpl(Context, Info.Holder(), Ret);
@@ -77,6 +277,7 @@ void FPropertyTranslator::Getter(
 void FPropertyTranslator::Setter(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
 
     FPropertyTranslator* This = static_cast<FPropertyTranslator*>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
@@ -86,42 +287,22 @@ void FPropertyTranslator::Setter(const v8::FunctionCallbackInfo<v8::Value>& Info
 void FPropertyTranslator::Setter(v8::Isolate* Isolate, v8::Local<v8::Context>& Context, v8::Local<v8::Value> Value,
     const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
-    if (!IsPropertyValid())
+    if (!IsPropertyValidCached())
     {
         FV8Utils::ThrowException(Isolate, "Property is invalid!");
         return;
     }
 
-    if (OwnerIsClass)
+    if (auto Container = GetContainer(Isolate, Info.Holder()))
     {
-        UObject* Object = FV8Utils::GetUObject(Info.Holder());
-        if (!Object)
-        {
-            FV8Utils::ThrowException(Isolate, "access a null object");
-            return;
-        }
-        if (FV8Utils::IsReleasedPtr(Object))
-        {
-            FV8Utils::ThrowException(Isolate, "access a invalid object");
-            return;
-        }
-        JsToUEInContainer(Isolate, Context, Value, Object, true);
-    }
-    else
-    {
-        auto Ptr = FV8Utils::GetPointer(Info.Holder());
-        if (!Ptr)
-        {
-            FV8Utils::ThrowException(Isolate, "access a null struct");
-            return;
-        }
-        JsToUEInContainer(Isolate, Context, Value, Ptr, true);
+        JsToUEInContainer(Isolate, Context, Value, Container, true);
     }
 }
 
 void FPropertyTranslator::DelegateGetter(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -129,7 +310,7 @@ void FPropertyTranslator::DelegateGetter(const v8::FunctionCallbackInfo<v8::Valu
 
     FPropertyTranslator* PropertyTranslator =
         static_cast<FPropertyTranslator*>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
-    if (!PropertyTranslator->IsPropertyValid())
+    if (!PropertyTranslator->IsPropertyValidCached())
     {
         FV8Utils::ThrowException(Isolate, "Property is invalid!");
         return;
@@ -171,8 +352,39 @@ void FPropertyTranslator::SetAccessor(v8::Isolate* Isolate, v8::Local<v8::Functi
     {
         auto OwnerStruct = Property->GetOwnerStruct();
         auto Self = v8::External::New(Isolate, this);
-        auto GetterTemplate = v8::FunctionTemplate::New(Isolate, Getter, Self);
-        auto SetterTemplate = v8::FunctionTemplate::New(Isolate, Setter, Self);
+        v8::FunctionCallback GetterCallback = Getter;
+        v8::FunctionCallback SetterCallback = Setter;
+        switch (FastAccessKind)
+        {
+            case EFastAccessKind::Int32:
+                GetterCallback = TFastPropertyAccessor<FInt32FastAccess>::Getter;
+                SetterCallback = TFastPropertyAccessor<FInt32FastAccess>::Setter;
+                break;
+            case EFastAccessKind::Byte:
+                GetterCallback = TFastPropertyAccessor<FByteFastAccess>::Getter;
+                SetterCallback = TFastPropertyAccessor<FByteFastAccess>::Setter;
+                break;
+            case EFastAccessKind::Float:
+                GetterCallback = TFastPropertyAccessor<FFloatFastAccess>::Getter;
+                SetterCallback = TFastPropertyAccessor<FFloatFastAccess>::Setter;
+                break;
+            case EFastAccessKind::Double:
+                GetterCallback = TFastPropertyAccessor<FDoubleFastAccess>::Getter;
+                SetterCallback = TFastPropertyAccessor<FDoubleFastAccess>::Setter;
+                break;
+            case EFastAccessKind::Bool:
+                GetterCallback = TFastPropertyAccessor<FBoolFastAccess>::Getter;
+                SetterCallback = TFastPropertyAccessor<FBoolFastAccess>::Setter;
+                break;
+            case EFastAccessKind::Name:
+                GetterCallback = TFastPropertyAccessor<FNameFastAccess>::Getter;
+                SetterCallback = TFastPropertyAccessor<FNameFastAccess>::Setter;
+                break;
+            default:
+                break;
+        }
+        auto GetterTemplate = v8::FunctionTemplate::New(Isolate, GetterCallback, Self);
+        auto SetterTemplate = v8::FunctionTemplate::New(Isolate, SetterCallback, Self);
 #if !defined(ENGINE_INDEPENDENT_JSENV)
         FString PropertyName = OwnerStruct && OwnerStruct->IsA<UUserDefinedStruct>() ?
 #if ENGINE_MINOR_VERSION >= 23 || ENGINE_MAJOR_VERSION > 4
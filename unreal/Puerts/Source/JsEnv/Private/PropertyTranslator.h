@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include "CoreMinimal.h"
@@ -32,6 +33,18 @@ PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 
 namespace PUERTS_NAMESPACE
 {
+// 可以直接按偏移读写的常见标量属性
+enum class EFastAccessKind : uint8
+{
+    None,
+    Int32,
+    Byte,
+    Float,
+    Double,
+    Bool,
+    Name
+};
+
 class FPropertyTranslator
 {
 public:
@@ -111,8 +124,10 @@ public:
     {
         Property = InProperty;
         PropertyWeakPtr = InProperty;
+        ValidEpoch = 0;
         OwnerIsClass = InProperty->GetOwnerClass() != nullptr;
         NeedLinkOuter = false;
+        InitFastAccess(InProperty);
         if (!OwnerIsClass)
         {
             if ((InProperty->IsA<StructPropertyMacro>() && StructProperty->Struct != FArrayBuffer::StaticStruct() &&
@@ -159,6 +174,10 @@ public:
 
     bool NeedLinkOuter;
 
+    EFastAccessKind FastAccessKind;
+
+    int32 Offset;
+
     size_t ParamShallowCopySize = 0;
 
     std::unique_ptr<FPropertyTranslator> Inner;
@@ -176,6 +195,34 @@ public:
 
     void SetAccessor(v8::Isolate* Isolate, v8::Local<v8::FunctionTemplate> Template);
 
+    void* GetContainer(v8::Isolate* Isolate, v8::Local<v8::Object> Holder);
+
+    // 有反射类型被释放时调用，之后每个属性下次访问时重新检查一次有效性
+    static void InvalidatePropertyValidity()
+    {
+        PropertyValidEpoch.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 非编辑器下属性只会随所属类型一起释放，类型未释放过就沿用上次的检查结果
+    FORCEINLINE bool IsPropertyValidCached()
+    {
+#if WITH_EDITOR
+        return IsPropertyValid();
+#else
+        const uint32 Epoch = PropertyValidEpoch.load(std::memory_order_relaxed);
+        if (ValidEpoch == Epoch)
+        {
+            return true;
+        }
+        if (!IsPropertyValid())
+        {
+            return false;
+        }
+        ValidEpoch = Epoch;
+        return true;
+#endif
+    }
+
     bool IsPropertyValid()
     {
         if (!PropertyWeakPtr.IsValid())
@@ -193,10 +240,16 @@ public:
     }
 
 private:
+    void InitFastAccess(PropertyMacro* InProperty);
+
 #if ENGINE_MINOR_VERSION < 25 && ENGINE_MAJOR_VERSION < 5
     TWeakObjectPtr<PropertyMacro> PropertyWeakPtr;
 #else
     TWeakFieldPtr<PropertyMacro> PropertyWeakPtr;
 #endif
+
+    uint32 ValidEpoch;
+
+    static std::atomic<uint32> PropertyValidEpoch;
 };
 }    // namespace PUERTS_NAMESPACE
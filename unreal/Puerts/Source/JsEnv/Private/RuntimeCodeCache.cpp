@@ -0,0 +1,179 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "RuntimeCodeCache.h"
+#include "V8Utils.h"
+#include "JSLogger.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Async/Async.h"
+
+#if !defined(WITH_QUICKJS)
+namespace PUERTS_NAMESPACE
+{
+struct FRuntimeCodeCacheHeader
+{
+    uint32 Magic;
+    uint32 VersionTag;
+    uint64 SourceHash;
+};
+
+static const uint32 RuntimeCodeCacheMagic = 0x31434350;    // "PCC1"
+
+FRuntimeCodeCache::FRuntimeCodeCache(const FString& InCacheDir)
+    : CacheDir(InCacheDir), VersionTag(v8::ScriptCompiler::CachedDataVersionTag())
+{
+}
+
+FRuntimeCodeCache::~FRuntimeCodeCache()
+{
+    WaitForWrites();
+}
+
+uint64 FRuntimeCodeCache::HashSource(v8::Isolate* Isolate, v8::Local<v8::String> Source)
+{
+    if (Source->IsExternalOneByte())
+    {
+        auto Resource = Source->GetExternalOneByteStringResource();
+        return CityHash64(Resource->data(), Resource->length());
+    }
+    const int32 Length = Source->Length();
+    if (Source->IsOneByte())
+    {
+        HashBuffer.SetNumUninitialized(Length, false);
+        Source->WriteOneByte(Isolate, HashBuffer.GetData(), 0, Length, v8::String::NO_NULL_TERMINATION);
+    }
+    else
+    {
+        HashBuffer.SetNumUninitialized(Length * sizeof(uint16_t), false);
+        Source->Write(Isolate, reinterpret_cast<uint16_t*>(HashBuffer.GetData()), 0, Length, v8::String::NO_NULL_TERMINATION);
+    }
+    return CityHash64(reinterpret_cast<const char*>(HashBuffer.GetData()), HashBuffer.Num());
+}
+
+FString FRuntimeCodeCache::GetCachePath(const FString& ScriptUrl) const
+{
+    const uint64 PathHash = CityHash64(reinterpret_cast<const char*>(*ScriptUrl), ScriptUrl.Len() * sizeof(TCHAR));
+    return CacheDir / FString::Printf(TEXT("%016llx.jscache"), PathHash);
+}
+
+bool FRuntimeCodeCache::Load(const FString& ScriptUrl, uint64 SourceHash, TArray<uint8>& OutCache)
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *GetCachePath(ScriptUrl), FILEREAD_Silent) ||
+        Data.Num() <= static_cast<int32>(sizeof(FRuntimeCodeCacheHeader)))
+    {
+        ++Misses;
+        return false;
+    }
+    FRuntimeCodeCacheHeader Header;
+    FMemory::Memcpy(&Header, Data.GetData(), sizeof(Header));
+    if (Header.Magic != RuntimeCodeCacheMagic || Header.VersionTag != VersionTag || Header.SourceHash != SourceHash)
+    {
+        ++Misses;
+        return false;
+    }
+    Data.RemoveAt(0, sizeof(Header), false);
+    OutCache = MoveTemp(Data);
+    return true;
+}
+
+void FRuntimeCodeCache::OnConsumed(const FString& ScriptUrl, bool InRejected)
+{
+    if (InRejected)
+    {
+        ++Rejected;
+        UE_LOG(Puerts, Warning, TEXT("runtime code cache for [%s] rejected, will regenerate"), *ScriptUrl);
+    }
+    else
+    {
+        ++Hits;
+    }
+}
+
+void FRuntimeCodeCache::Add(
+    v8::Isolate* Isolate, const FString& ScriptUrl, uint64 SourceHash, v8::Local<v8::UnboundScript> Script)
+{
+    FPendingScript Pending;
+    Pending.ScriptUrl = ScriptUrl;
+    Pending.SourceHash = SourceHash;
+    Pending.Script.Reset(Isolate, Script);
+    PendingScripts.push_back(std::move(Pending));
+}
+
+void FRuntimeCodeCache::DiscardPending()
+{
+    PendingScripts.clear();
+    PendingScripts.shrink_to_fit();
+    HashBuffer.Empty();
+}
+
+void FRuntimeCodeCache::Flush(v8::Isolate* Isolate)
+{
+    if (PendingScripts.empty())
+    {
+        return;
+    }
+    v8::HandleScope HandleScope(Isolate);
+    TArray<TPair<FString, TArray<uint8>>> Files;
+    for (auto& Pending : PendingScripts)
+    {
+        v8::ScriptCompiler::CachedData* CachedCode = v8::ScriptCompiler::CreateCodeCache(Pending.Script.Get(Isolate));
+        if (!CachedCode)
+        {
+            continue;
+        }
+        FRuntimeCodeCacheHeader Header = {RuntimeCodeCacheMagic, VersionTag, Pending.SourceHash};
+        TArray<uint8> Data;
+        Data.Reserve(sizeof(Header) + CachedCode->length);
+        Data.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+        Data.Append(CachedCode->data, CachedCode->length);
+#if !WITH_EDITOR
+        delete CachedCode;
+#else
+        // 编辑器下是v8.dll分配的，ue里的delete被重载了不能直接delete，析构函数在v8.dll里执行，会释放缓存数据本身
+        CachedCode->~CachedData();
+#endif
+        Files.Emplace(GetCachePath(Pending.ScriptUrl), MoveTemp(Data));
+    }
+    PendingScripts.clear();
+
+    PendingWrites.RemoveAll([](const TFuture<void>& Write) { return Write.IsReady(); });
+    if (Files.Num() > 0)
+    {
+        // 同步写文件会卡住游戏线程，交给线程池
+        PendingWrites.Add(Async(EAsyncExecution::ThreadPool,
+            [this, Files = MoveTemp(Files)]()
+            {
+                for (const auto& File : Files)
+                {
+                    if (FFileHelper::SaveArrayToFile(File.Value, *File.Key))
+                    {
+                        ++Written;
+                    }
+                }
+            }));
+    }
+}
+
+void FRuntimeCodeCache::WaitForWrites()
+{
+    for (auto& Write : PendingWrites)
+    {
+        Write.Wait();
+    }
+    PendingWrites.Empty();
+}
+
+FString FRuntimeCodeCache::GetStatistics() const
+{
+    return FString::Printf(
+        TEXT("runtime code cache: %d hits, %d misses, %d rejected, %d written"), Hits, Misses, Rejected, Written.load());
+}
+}    // namespace PUERTS_NAMESPACE
+#endif
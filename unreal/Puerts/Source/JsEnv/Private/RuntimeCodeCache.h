@@ -0,0 +1,90 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+#include "NamespaceDef.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "libplatform/libplatform.h"
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+#include <atomic>
+#include <vector>
+
+#if !defined(WITH_QUICKJS)
+namespace PUERTS_NAMESPACE
+{
+// 运行时为CommonJS模块生成code cache并存到本地，下次启动时直接使用，免去v8cc离线编译这一步
+// 每个模块一个缓存文件，文件名由模块路径决定，
+// 内容校验源码哈希和V8版本及flag，不一致时视为未命中并重新生成
+class FRuntimeCodeCache
+{
+public:
+    explicit FRuntimeCodeCache(const FString& InCacheDir);
+
+    ~FRuntimeCodeCache();
+
+    uint64 HashSource(v8::Isolate* Isolate, v8::Local<v8::String> Source);
+
+    // 命中时OutCache为V8的code cache数据，需保持有效直到编译结束
+    bool Load(const FString& ScriptUrl, uint64 SourceHash, TArray<uint8>& OutCache);
+
+    void OnConsumed(const FString& ScriptUrl, bool Rejected);
+
+    // 首次执行后再生成缓存，这样模块初始化时编译的函数也会包含在内
+    void Add(v8::Isolate* Isolate, const FString& ScriptUrl, uint64 SourceHash, v8::Local<v8::UnboundScript> Script);
+
+    // 为待保存的脚本生成缓存，需要在Isolate内调用，写盘在后台线程进行
+    void Flush(v8::Isolate* Isolate);
+
+    // 丢弃还没生成缓存的脚本并释放hash缓冲区，用于堆接近上限时的应急清理
+    void DiscardPending();
+
+    // 等待已提交的写盘完成
+    void WaitForWrites();
+
+    FString GetStatistics() const;
+
+private:
+    FString GetCachePath(const FString& ScriptUrl) const;
+
+    struct FPendingScript
+    {
+        FString ScriptUrl;
+        uint64 SourceHash;
+        v8::Global<v8::UnboundScript> Script;
+    };
+
+    FString CacheDir;
+
+    uint32 VersionTag;
+
+    std::vector<FPendingScript> PendingScripts;
+
+    TArray<TFuture<void>> PendingWrites;
+
+    // 非外部字符串的源码先拷到这里再算hash，复用避免每个模块都分配
+    TArray<uint8> HashBuffer;
+
+    int32 Hits = 0;
+
+    int32 Misses = 0;
+
+    int32 Rejected = 0;
+
+    std::atomic<int32> Written{0};
+};
+}    // namespace PUERTS_NAMESPACE
+#endif
@@ -11,14 +11,70 @@ v8::Local<v8::FunctionTemplate> FSoftObjectWrapper::ToFunctionTemplate(v8::Isola
     Result->PrototypeTemplate()->Set(
         FV8Utils::ToV8String(Isolate, "LoadSynchronous"), v8::FunctionTemplate::New(Isolate, &LoadSynchronous));
     Result->PrototypeTemplate()->Set(FV8Utils::ToV8String(Isolate, "Get"), v8::FunctionTemplate::New(Isolate, &Get));
+#if !defined(WITH_QUICKJS)
+    Result->PrototypeTemplate()->Set(FV8Utils::ToV8String(Isolate, "LoadAsync"), v8::FunctionTemplate::New(Isolate, &LoadAsync));
+#endif
     return Result;
 }
 
+bool FSoftObjectWrapper::GetExpectClasses(
+    const v8::FunctionCallbackInfo<v8::Value>& Info, UClass*& PropertyClass, UClass*& MetaClass)
+{
+    auto Isolate = Info.GetIsolate();
+    PropertyClass = nullptr;
+    MetaClass = nullptr;
+    if (UObject* Object = FV8Utils::GetUObject(Info.Holder(), 1))
+    {
+        if (FV8Utils::IsReleasedPtr(Object))
+        {
+            FV8Utils::ThrowException(Isolate, "passing a invalid object");
+            return false;
+        }
+        PropertyClass = Cast<UClass>(Object);
+    }
+
+    if (UObject* Object = FV8Utils::GetUObject(Info.Holder(), 2))
+    {
+        if (FV8Utils::IsReleasedPtr(Object))
+        {
+            FV8Utils::ThrowException(Isolate, "passing a invalid object");
+            return false;
+        }
+        MetaClass = Cast<UClass>(Object);
+    }
+    return true;
+}
+
+bool FSoftObjectWrapper::IsExpectType(UObject* Obj, UClass* PropertyClass, UClass* MetaClass)
+{
+    if (PropertyClass && !Obj->GetClass()->IsChildOf(PropertyClass))
+    {
+        // FV8Utils::ThrowException(Isolate, "invalid type");
+        return false;
+    }
+    if (MetaClass)
+    {
+        auto Class = Cast<UClass>(Obj);
+        if (!Class)
+        {
+            // FV8Utils::ThrowException(Isolate, "not a class");
+            return false;
+        }
+        if (!Class->IsChildOf(MetaClass))
+        {
+            // FV8Utils::ThrowException(Isolate, "not a expect class");
+            return false;
+        }
+    }
+    return true;
+}
+
 typedef UObject* (*FSoftObjectPtrObjectGetter)(FSoftObjectPtr* Ptr);
 
 static void GenericObjectGet(const v8::FunctionCallbackInfo<v8::Value>& Info, FSoftObjectPtrObjectGetter Getter)
 {
     auto Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     auto Context = Isolate->GetCurrentContext();
 
     FSoftObjectPtr* Ptr = FV8Utils::GetPointerFast<FSoftObjectPtr>(Info.Holder());
@@ -31,47 +87,13 @@ static void GenericObjectGet(const v8::FunctionCallbackInfo<v8::Value>& Info, FS
 
     if (Obj)
     {
-        UClass* PropertyClass = nullptr;
-        if (UObject* Object = FV8Utils::GetUObject(Info.Holder(), 1))
+        UClass* PropertyClass;
+        UClass* MetaClass;
+        if (!FSoftObjectWrapper::GetExpectClasses(Info, PropertyClass, MetaClass) ||
+            !FSoftObjectWrapper::IsExpectType(Obj, PropertyClass, MetaClass))
         {
-            if (FV8Utils::IsReleasedPtr(Object))
-            {
-                FV8Utils::ThrowException(Isolate, "passing a invalid object");
-                return;
-            }
-            PropertyClass = Cast<UClass>(Object);
-        }
-
-        UClass* MetaClass = nullptr;
-        if (UObject* Object = FV8Utils::GetUObject(Info.Holder(), 2))
-        {
-            if (FV8Utils::IsReleasedPtr(Object))
-            {
-                FV8Utils::ThrowException(Isolate, "passing a invalid object");
-                return;
-            }
-            MetaClass = Cast<UClass>(Object);
-        }
-
-        if (PropertyClass && !Obj->GetClass()->IsChildOf(PropertyClass))
-        {
-            // FV8Utils::ThrowException(Isolate, "invalid type");
             return;
         }
-        if (MetaClass)
-        {
-            auto Class = Cast<UClass>(Obj);
-            if (!Class)
-            {
-                // FV8Utils::ThrowException(Isolate, "not a class");
-                return;
-            }
-            if (!Class->IsChildOf(MetaClass))
-            {
-                // FV8Utils::ThrowException(Isolate, "not a expect class");
-                return;
-            }
-        }
 
         Info.GetReturnValue().Set(FV8Utils::IsolateData<IObjectMapper>(Isolate)->FindOrAdd(Isolate, Context, Obj->GetClass(), Obj));
     }
@@ -86,4 +108,28 @@ void FSoftObjectWrapper::Get(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     GenericObjectGet(Info, [](FSoftObjectPtr* Ptr) { return Ptr->Get(); });
 }
+
+#if !defined(WITH_QUICKJS)
+void FSoftObjectWrapper::LoadAsync(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    auto Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
+    auto Context = Isolate->GetCurrentContext();
+
+    FSoftObjectPtr* Ptr = FV8Utils::GetPointerFast<FSoftObjectPtr>(Info.Holder());
+    if (!Ptr)
+    {
+        FV8Utils::ThrowException(Isolate, "passing a invalid object for FSoftObjectPtr");
+        return;
+    }
+    UClass* PropertyClass;
+    UClass* MetaClass;
+    if (!GetExpectClasses(Info, PropertyClass, MetaClass))
+    {
+        return;
+    }
+    Info.GetReturnValue().Set(FV8Utils::IsolateData<IObjectMapper>(Isolate)->LoadSoftObjectAsync(
+        Isolate, Context, Ptr->ToSoftObjectPath(), PropertyClass, MetaClass));
+}
+#endif
 }    // namespace PUERTS_NAMESPACE
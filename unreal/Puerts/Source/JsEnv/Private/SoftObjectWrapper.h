@@ -26,9 +26,18 @@ class FSoftObjectWrapper
 public:
     static v8::Local<v8::FunctionTemplate> ToFunctionTemplate(v8::Isolate* Isolate);
 
+    static bool GetExpectClasses(const v8::FunctionCallbackInfo<v8::Value>& Info, UClass*& PropertyClass, UClass*& MetaClass);
+
+    static bool IsExpectType(UObject* Obj, UClass* PropertyClass, UClass* MetaClass);
+
 private:
+
     static void LoadSynchronous(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+#if !defined(WITH_QUICKJS)
+    static void LoadAsync(const v8::FunctionCallbackInfo<v8::Value>& Info);
+#endif
+
     static void Get(const v8::FunctionCallbackInfo<v8::Value>& Info);
 };
 }    // namespace PUERTS_NAMESPACE
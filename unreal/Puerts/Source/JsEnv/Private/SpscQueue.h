@@ -0,0 +1,82 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 THL A29 Limited, a Tencent company.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+#if !defined(PUERTS_NAMESPACE)
+#if defined(WITH_QJS_NAMESPACE_SUFFIX)
+#define PUERTS_NAMESPACE puerts_qjs
+#else
+#define PUERTS_NAMESPACE puerts
+#endif
+#endif
+
+namespace PUERTS_NAMESPACE
+{
+// 单生产者单消费者的无锁队列，用于网络线程和游戏线程之间传递消息
+template <typename T>
+class SpscQueue
+{
+public:
+    SpscQueue()
+    {
+        Head = Tail = new Node();
+    }
+
+    ~SpscQueue()
+    {
+        while (Head)
+        {
+            Node* Next = Head->Next.load(std::memory_order_relaxed);
+            delete Head;
+            Head = Next;
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // 仅生产者线程调用
+    void Push(T&& Value)
+    {
+        Node* NewNode = new Node();
+        NewNode->Value = std::move(Value);
+        Tail->Next.store(NewNode, std::memory_order_release);
+        Tail = NewNode;
+    }
+
+    // 仅消费者线程调用
+    bool Pop(T& OutValue)
+    {
+        Node* Next = Head->Next.load(std::memory_order_acquire);
+        if (!Next)
+        {
+            return false;
+        }
+        OutValue = std::move(Next->Value);
+        delete Head;
+        Head = Next;
+        return true;
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> Next{nullptr};
+        T Value;
+    };
+
+    Node* Head;
+
+    Node* Tail;
+};
+}    // namespace PUERTS_NAMESPACE
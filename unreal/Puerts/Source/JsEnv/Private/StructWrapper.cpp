@@ -368,6 +368,7 @@ v8::Local<v8::FunctionTemplate> FStructWrapper::ToFunctionTemplate(v8::Isolate*
                 if (Property->IsSymbol())
                     return;
                 auto InnerIsolate = Info.GetIsolate();
+                CHECK_UE_ACCESS_THREAD(InnerIsolate);
                 auto Context = InnerIsolate->GetCurrentContext();
                 auto This = Info.This();
                 FName RequiredFName(*FV8Utils::ToFString(Info.GetIsolate(), Property));
@@ -412,6 +413,7 @@ v8::Local<v8::FunctionTemplate> FStructWrapper::ToFunctionTemplate(v8::Isolate*
                 if (Property->IsSymbol())
                     return;
                 auto InnerIsolate = Info.GetIsolate();
+                CHECK_UE_ACCESS_THREAD(InnerIsolate);
                 auto Context = InnerIsolate->GetCurrentContext();
                 auto This = Info.This();
                 FName RequiredFName(*FV8Utils::ToFString(Info.GetIsolate(), Property));
@@ -456,6 +458,7 @@ v8::Local<v8::FunctionTemplate> FStructWrapper::ToFunctionTemplate(v8::Isolate*
 void FStructWrapper::StaticClass(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -477,6 +480,7 @@ void FStructWrapper::StaticClass(const v8::FunctionCallbackInfo<v8::Value>& Info
 void FStructWrapper::Find(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -528,6 +532,7 @@ void FStructWrapper::Find(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FStructWrapper::Load(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -572,6 +577,7 @@ void FStructWrapper::Load(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FScriptStructWrapper::New(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -666,6 +672,7 @@ void FClassWrapper::OnGarbageCollected(const v8::WeakCallbackInfo<UClass>& Data)
 void FClassWrapper::New(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    CHECK_UE_ACCESS_THREAD(Isolate);
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
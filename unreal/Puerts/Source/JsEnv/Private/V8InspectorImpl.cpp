@@ -17,6 +17,7 @@
 #if (PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX || defined(WITH_INSPECTOR)) && !defined(WITHOUT_INSPECTOR)
 
 #include "V8InspectorImpl.h"
+#include "SpscQueue.h"
 
 #if USING_UE
 #include "UECompatible.h"
@@ -26,6 +27,9 @@
 #include <string>
 #include <locale>
 #include <codecvt>
+#include <chrono>
+#include <thread>
+#include <atomic>
 
 PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
 #pragma warning(push)
@@ -57,6 +61,19 @@ DEFINE_LOG_CATEGORY_STATIC(LogV8Inspector, Log, All);
 
 namespace PUERTS_NAMESPACE
 {
+static std::string InspectorUtf16ToUtf8(const std::u16string& Utf16)
+{
+#if PLATFORM_WINDOWS
+#pragma warning(disable : 4996)
+    std::wstring_convert<std::codecvt_utf8_utf16<uint16_t>, uint16_t> Conv;
+    const uint16_t* Start = reinterpret_cast<const uint16_t*>(Utf16.data());
+#else
+    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> Conv;
+    const char16_t* Start = Utf16.data();
+#endif
+    return Conv.to_bytes(Start, Start + Utf16.length());
+}
+
 class V8InspectorChannelImpl : public v8_inspector::V8Inspector::Channel, public V8InspectorChannel
 {
 public:
@@ -66,9 +83,13 @@ public:
 
     void OnMessage(std::function<void(const std::string&)> Handler) override;
 
+    // 直接把v8的消息交给调用者，编码转换由调用者在其他线程完成
+    void OnRawMessage(std::function<void(const v8_inspector::StringView&)> Handler);
+
     virtual ~V8InspectorChannelImpl() override
     {
         OnSendMessage = nullptr;
+        OnSendRawMessage = nullptr;
     }
 
 private:
@@ -86,6 +107,8 @@ private:
 
     std::function<void(const std::string&)> OnSendMessage;
 
+    std::function<void(const v8_inspector::StringView&)> OnSendRawMessage;
+
     v8::Isolate* Isolate;
 };
 
@@ -121,26 +144,30 @@ void V8InspectorChannelImpl::OnMessage(std::function<void(const std::string&)> H
     OnSendMessage = Handler;
 }
 
+void V8InspectorChannelImpl::OnRawMessage(std::function<void(const v8_inspector::StringView&)> Handler)
+{
+    OnSendRawMessage = Handler;
+}
+
 void V8InspectorChannelImpl::SendMessage(v8_inspector::StringBuffer& MessageBuffer)
 {
     v8_inspector::StringView MessageView = MessageBuffer.string();
 
+    if (OnSendRawMessage)
+    {
+        OnSendRawMessage(MessageView);
+        return;
+    }
+
     std::string Message;
     if (MessageView.is8Bit())
     {
-        Message = reinterpret_cast<const char*>(MessageView.characters8());
+        Message.assign(reinterpret_cast<const char*>(MessageView.characters8()), MessageView.length());
     }
     else
     {
-#if PLATFORM_WINDOWS
-#pragma warning(disable : 4996)
-        std::wstring_convert<std::codecvt_utf8_utf16<uint16_t>, uint16_t> Conv;
-        const uint16_t* Start = MessageView.characters16();
-#else
-        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> Conv;
         const char16_t* Start = reinterpret_cast<const char16_t*>(MessageView.characters16());
-#endif
-        Message = Conv.to_bytes(Start, Start + MessageView.length());
+        Message = InspectorUtf16ToUtf8(std::u16string(Start, Start + MessageView.length()));
     }
 
     if (OnSendMessage)
@@ -193,18 +220,50 @@ public:
     V8InspectorChannel* CreateV8InspectorChannel() override;
 
 private:
+    enum class EInboundEvent
+    {
+        Open,
+        Message,
+        Close
+    };
+
+    struct FInboundEvent
+    {
+        EInboundEvent Type;
+        wspp_connection_hdl Handle;
+        // 入队时在网络线程取得，关闭事件到达游戏线程时连接可能已经释放，不能再从Handle取
+        void* Key;
+        std::string Payload;
+    };
+
+    struct FOutboundMessage
+    {
+        wspp_connection_hdl Handle;
+        std::string Utf8;
+        std::u16string Utf16;
+    };
+
+    // 以下回调运行在网络线程
     void OnHTTP(wspp_connection_hdl Handle);
 
     void OnOpen(wspp_connection_hdl Handle);
 
     void OnReceiveMessage(wspp_connection_hdl Handle, wspp_message_ptr Message);
 
-    void OnSendMessage(wspp_connection_hdl Handle, const std::string& Message);
-
     void OnClose(wspp_connection_hdl Handle);
 
     void OnFail(wspp_connection_hdl Handle);
 
+    void FlushOutbound();
+
+    // 以下运行在游戏线程
+    void OnSendMessage(wspp_connection_hdl Handle, const v8_inspector::StringView& Message);
+
+    // 安全点：把网络线程收到的消息派发进v8，暂停在断点时也会执行
+    bool DispatchInbound();
+
+    void StopIOThread();
+
     void runMessageLoopOnPause(int ContextGroupId) override;
 
     void quitMessageLoopOnPause() override;
@@ -234,6 +293,17 @@ private:
 
     wspp_server Server;
 
+    std::thread IOThread;
+
+    // 网络线程因异常退出，游戏线程下次Tick时关闭所有连接
+    std::atomic<bool> IOThreadFailed;
+
+    SpscQueue<FInboundEvent> InboundQueue;
+
+    SpscQueue<FOutboundMessage> OutboundQueue;
+
+    bool HasPendingOutbound;
+
     std::string JSONVersion;
 
     std::string JSONList;
@@ -290,6 +360,8 @@ V8InspectorClientImpl::V8InspectorClientImpl(int32_t InPort, v8::Local<v8::Conte
     Port = InPort;
     IsAlive = false;
     Connected = false;
+    HasPendingOutbound = false;
+    IOThreadFailed = false;
 
     static int32_t CurrentCtxGroupID = 1;
     CtxGroupID = CurrentCtxGroupID++;
@@ -340,6 +412,34 @@ V8InspectorClientImpl::V8InspectorClientImpl(int32_t InPort, v8::Local<v8::Conte
 
         IsAlive = true;
 
+        IOThread = std::thread(
+            [this]()
+            {
+                try
+                {
+                    Server.run();
+                }
+                catch (const wspp_exception& Exception)
+                {
+#if USING_UE
+                    ReportException(Exception, TEXT("IOThread"));
+#else
+                    puerts::PLog(puerts::Error, "IOThread: %s", Exception.what());
+#endif
+                    IOThreadFailed = true;
+                }
+                catch (const std::exception& Exception)
+                {
+                    // 不能让异常逃出线程函数，否则直接std::terminate
+#if USING_UE
+                    UE_LOG(LogV8Inspector, Warning, TEXT("IOThread, message:%s"), UTF8_TO_TCHAR(Exception.what()));
+#else
+                    puerts::PLog(puerts::Error, "IOThread: %s", Exception.what());
+#endif
+                    IOThreadFailed = true;
+                }
+            });
+
 #if USING_UE
         FString InspectorUrl =
             FString::Printf(TEXT("devtools://devtools/bundled/inspector.html?v8only=true&ws=127.0.0.1:%d"), Port);
@@ -381,6 +481,15 @@ V8InspectorClientImpl::~V8InspectorClientImpl()
 #endif
 }
 
+void V8InspectorClientImpl::StopIOThread()
+{
+    if (IOThread.joinable())
+    {
+        Server.stop();
+        IOThread.join();
+    }
+}
+
 void V8InspectorClientImpl::Close()
 {
     if (IsAlive)
@@ -388,7 +497,27 @@ void V8InspectorClientImpl::Close()
 #ifdef THREAD_SAFE
         v8::Locker Locker(Isolate);
 #endif
-        Server.stop_listening();
+        StopIOThread();
+        try
+        {
+            Server.stop_listening();
+        }
+        catch (const wspp_exception& Exception)
+        {
+#if USING_UE
+            ReportException(Exception, TEXT("Close"));
+#else
+            puerts::PLog(puerts::Error, "Close: %s", Exception.what());
+#endif
+        }
+        catch (const std::exception& Exception)
+        {
+#if USING_UE
+            UE_LOG(LogV8Inspector, Warning, TEXT("Close, message:%s"), UTF8_TO_TCHAR(Exception.what()));
+#else
+            puerts::PLog(puerts::Error, "Close: %s", Exception.what());
+#endif
+        }
         for (auto Iter = V8InspectorChannels.begin(); Iter != V8InspectorChannels.end(); ++Iter)
         {
             delete Iter->second;
@@ -405,6 +534,13 @@ void V8InspectorClientImpl::Close()
 
 bool V8InspectorClientImpl::Tick(float /* DeltaTime */)
 {
+    if (IOThreadFailed)
+    {
+        // 网络线程已经退出，连接不会再有收发，直接关闭并释放所有session
+        IOThreadFailed = false;
+        Close();
+    }
+
     try
     {
         if (IsAlive)
@@ -413,10 +549,9 @@ bool V8InspectorClientImpl::Tick(float /* DeltaTime */)
             v8::Locker Locker(Isolate);
 #endif
 
+            // 网络收发在IOThread，这里只派发已收到的消息，没有消息时不进入v8
+            if (DispatchInbound())
             {
-                // v8::Locker lock(Isolate);
-                Server.poll();
-
                 v8::Isolate::Scope IsolateScope(Isolate);
                 v8::HandleScope HandleScope(Isolate);
                 auto LocalContext = Context.Get(Isolate);
@@ -444,6 +579,68 @@ bool V8InspectorClientImpl::Tick()
     return IsAlive && Connected;
 }
 
+bool V8InspectorClientImpl::DispatchInbound()
+{
+    bool Dispatched = false;
+    FInboundEvent Event;
+    if (InboundQueue.Pop(Event))
+    {
+        // 创建/删除session和派发消息都要在isolate内
+        v8::Isolate::Scope IsolateScope(Isolate);
+        v8::HandleScope HandleScope(Isolate);
+        do
+        {
+            switch (Event.Type)
+            {
+                case EInboundEvent::Open:
+                {
+                    V8InspectorChannelImpl* Channel = static_cast<V8InspectorChannelImpl*>(CreateV8InspectorChannel());
+                    V8InspectorChannels[Event.Key] = Channel;
+                    Channel->OnRawMessage(
+                        std::bind(&V8InspectorClientImpl::OnSendMessage, this, Event.Handle, std::placeholders::_1));
+#if USING_UE
+                    UE_LOG(LogV8Inspector, Display, TEXT("Inspector: Connect"));
+#else
+                    puerts::PLog(puerts::Log, "Inspector: Connect");
+#endif
+                    break;
+                }
+                case EInboundEvent::Message:
+                {
+                    auto Iter = V8InspectorChannels.find(Event.Key);
+                    if (Iter != V8InspectorChannels.end())
+                    {
+                        Iter->second->DispatchProtocolMessage(Event.Payload);
+                        Dispatched = true;
+                    }
+                    break;
+                }
+                case EInboundEvent::Close:
+                {
+                    auto Iter = V8InspectorChannels.find(Event.Key);
+                    if (Iter != V8InspectorChannels.end())
+                    {
+                        delete Iter->second;
+                        V8InspectorChannels.erase(Iter);
+                    }
+#if USING_UE
+                    UE_LOG(LogV8Inspector, Display, TEXT("Inspector: Disconnect"));
+#endif
+                    break;
+                }
+            }
+        } while (InboundQueue.Pop(Event));
+    }
+
+    if (HasPendingOutbound)
+    {
+        HasPendingOutbound = false;
+        // 一批消息只唤醒一次网络线程
+        Server.get_io_service().post(std::bind(&V8InspectorClientImpl::FlushOutbound, this));
+    }
+    return Dispatched;
+}
+
 void V8InspectorClientImpl::OnHTTP(wspp_connection_hdl Handle)
 {
     try
@@ -494,14 +691,7 @@ void V8InspectorClientImpl::OnHTTP(wspp_connection_hdl Handle)
 
 void V8InspectorClientImpl::OnOpen(wspp_connection_hdl Handle)
 {
-    V8InspectorChannelImpl* channel = static_cast<V8InspectorChannelImpl*>(CreateV8InspectorChannel());
-    V8InspectorChannels[Handle.lock().get()] = channel;
-    channel->OnMessage(std::bind(&V8InspectorClientImpl::OnSendMessage, this, Handle, std::placeholders::_1));
-#if USING_UE
-    UE_LOG(LogV8Inspector, Display, TEXT("Inspector: Connect"));
-#else
-    puerts::PLog(puerts::Log, "Inspector: Connect");
-#endif
+    InboundQueue.Push(FInboundEvent{EInboundEvent::Open, Handle, Handle.lock().get(), std::string()});
 }
 
 void V8InspectorClientImpl::OnReceiveMessage(wspp_connection_hdl Handle, wspp_message_ptr Message)
@@ -511,46 +701,59 @@ void V8InspectorClientImpl::OnReceiveMessage(wspp_connection_hdl Handle, wspp_me
     //#else
     //    puerts::PLog(puerts::Log, "<---: %s", Message->get_payload().c_str());
     //#endif
-    auto channel = V8InspectorChannels[Handle.lock().get()];
+    InboundQueue.Push(
+        FInboundEvent{EInboundEvent::Message, Handle, Handle.lock().get(), std::move(Message->get_raw_payload())});
+}
 
+void V8InspectorClientImpl::OnSendMessage(wspp_connection_hdl Handle, const v8_inspector::StringView& Message)
+{
+    FOutboundMessage Outbound;
+    Outbound.Handle = Handle;
+    if (Message.is8Bit())
     {
-        // v8::Locker Locker(Isolate);
-        v8::Isolate::Scope IsolateScope(Isolate);
-        v8::SealHandleScope scope(Isolate);
-        channel->DispatchProtocolMessage(Message->get_payload());
+        Outbound.Utf8.assign(reinterpret_cast<const char*>(Message.characters8()), Message.length());
+    }
+    else
+    {
+        const char16_t* Start = reinterpret_cast<const char16_t*>(Message.characters16());
+        Outbound.Utf16.assign(Start, Start + Message.length());
     }
+    OutboundQueue.Push(std::move(Outbound));
+    HasPendingOutbound = true;
 }
 
-void V8InspectorClientImpl::OnSendMessage(wspp_connection_hdl Handle, const std::string& Message)
+void V8InspectorClientImpl::FlushOutbound()
 {
     //#if USING_UE
     //    UE_LOG(LogV8Inspector, Display, TEXT("--->: %s"), ANSI_TO_TCHAR(Message.c_str()));
     //#else
     //    puerts::PLog(puerts::Log, "--->: %s", Message.c_str());
     //#endif
-
-    try
-    {
-        Server.send(Handle, Message, websocketpp::frame::opcode::TEXT);
-    }
-    catch (const websocketpp::exception& Exception)
+    FOutboundMessage Outbound;
+    while (OutboundQueue.Pop(Outbound))
     {
+        try
+        {
+            if (!Outbound.Utf16.empty())
+            {
+                Outbound.Utf8 = InspectorUtf16ToUtf8(Outbound.Utf16);
+            }
+            Server.send(Outbound.Handle, Outbound.Utf8, websocketpp::frame::opcode::TEXT);
+        }
+        catch (const websocketpp::exception& Exception)
+        {
 #if USING_UE
-        ReportException(Exception, TEXT("OnSendMessage"));
+            ReportException(Exception, TEXT("OnSendMessage"));
 #else
-        puerts::PLog(puerts::Error, "OnSendMessage: %s", Exception.what());
+            puerts::PLog(puerts::Error, "OnSendMessage: %s", Exception.what());
 #endif
+        }
     }
 }
 
 void V8InspectorClientImpl::OnClose(wspp_connection_hdl Handle)
 {
-    void* HandlePtr = Handle.lock().get();
-    delete V8InspectorChannels[HandlePtr];
-    V8InspectorChannels.erase(HandlePtr);
-#if USING_UE
-    UE_LOG(LogV8Inspector, Display, TEXT("Inspector: Disconnect"));
-#endif
+    InboundQueue.Push(FInboundEvent{EInboundEvent::Close, Handle, Handle.lock().get(), std::string()});
 }
 
 void V8InspectorClientImpl::OnFail(wspp_connection_hdl Handle)
@@ -573,9 +776,13 @@ void V8InspectorClientImpl::runMessageLoopOnPause(int /* ContextGroupId */)
 
     IsPaused = true;
 
-    while (IsPaused)
+    // 网络线程退出后不会再收到resume，退出暂停交给Tick关闭
+    while (IsPaused && IsAlive && !IOThreadFailed)
     {
-        Tick();
+        if (!DispatchInbound())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
     }
 }
 
@@ -16,4 +16,16 @@ FString puerts::FV8Utils::ToFString(v8::Isolate* Isolate, v8::Local<v8::Value> V
 #else
     return UTF16_TO_TCHAR(*(v8::String::Value(Isolate, Value)));
 #endif
-}
\ No newline at end of file
+}
+
+static thread_local bool GIsJsEnvWorkerThread = false;
+
+void puerts::FV8Utils::SetWorkerThread(bool InIsWorkerThread)
+{
+    GIsJsEnvWorkerThread = InIsWorkerThread;
+}
+
+bool puerts::FV8Utils::IsWorkerThread()
+{
+    return GIsJsEnvWorkerThread;
+}
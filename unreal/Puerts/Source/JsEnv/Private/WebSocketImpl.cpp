@@ -10,6 +10,7 @@
 
 #include "V8InspectorImpl.h"    // for PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
 #include "V8Utils.h"
+#include "SpscQueue.h"
 
 #ifndef THIRD_PARTY_INCLUDES_START
 #define THIRD_PARTY_INCLUDES_START
@@ -44,6 +45,8 @@ THIRD_PARTY_INCLUDES_END
 PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 
 #include <sstream>
+#include <thread>
+#include <cstring>
 
 namespace PUERTS_NAMESPACE
 {
@@ -94,6 +97,8 @@ class V8WebSocketClientImpl
 public:
     V8WebSocketClientImpl(v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Object> InSelf);
 
+    ~V8WebSocketClientImpl();
+
 #if defined(WITH_WEBSOCKET_SSL)
     using wspp_client = websocketpp::client<websocketpp::config::asio_tls>;
 #else
@@ -128,6 +133,16 @@ public:
     void PollOne();
 
 private:
+    struct FWebSocketEvent
+    {
+        HandlerType Type;
+        wspp_connection_hdl Handle;
+        wspp_message_ptr Message;
+        int CloseCode;
+        std::string Reason;
+    };
+
+    // 使用后台线程时以下回调运行在网络线程，只构造事件，不访问v8
     void OnOpen(wspp_connection_hdl Handle);
 
     void OnMessage(wspp_connection_hdl Handle, wspp_message_ptr Message);
@@ -136,6 +151,14 @@ private:
 
     void OnFail(wspp_connection_hdl Handle);
 
+    void PushEvent(FWebSocketEvent&& Event);
+
+    void DispatchEvent(FWebSocketEvent& Event);
+
+    v8::Local<v8::Value> MessageToValue(wspp_message_ptr Message);
+
+    void StopIOThread();
+
     void Cleanup();
 
 private:
@@ -152,6 +175,13 @@ private:
     bool Connenting = false;
 
     v8::Global<v8::Function> Handles[HANDLE_TYPE_END];
+
+    // 为true时事件循环运行在IOThread，收到的事件经EventQueue在poll时批量派发给js
+    bool UseIOThread = false;
+
+    std::thread IOThread;
+
+    SpscQueue<FWebSocketEvent> EventQueue;
 };
 
 static void OnGarbageCollectedWithFree(const v8::WeakCallbackInfo<V8WebSocketClientImpl>& Data)
@@ -168,6 +198,54 @@ V8WebSocketClientImpl::V8WebSocketClientImpl(v8::Isolate* InIsolate, v8::Local<v
     // UE_LOG(LogTemp, Warning, TEXT(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> set weak %p"), this);
 }
 
+V8WebSocketClientImpl::~V8WebSocketClientImpl()
+{
+    StopIOThread();
+}
+
+void V8WebSocketClientImpl::StopIOThread()
+{
+    if (IOThread.joinable())
+    {
+        Client.stop();
+        IOThread.join();
+    }
+}
+
+#if !defined(HAS_ARRAYBUFFER_NEW_WITHOUT_STL) && !defined(USING_IN_UNREAL_ENGINE)
+static void OnMessageBackingStoreFree(void* Data, size_t Length, void* DeleterData)
+{
+    delete static_cast<V8WebSocketClientImpl::wspp_message_ptr*>(DeleterData);
+}
+#endif
+
+v8::Local<v8::Value> V8WebSocketClientImpl::MessageToValue(wspp_message_ptr Message)
+{
+    const std::string& Payload = Message->get_payload();
+    if (Message->get_opcode() == websocketpp::frame::opcode::TEXT)
+    {
+        return v8::String::NewFromUtf8(Isolate, Payload.c_str(), v8::NewStringType::kNormal, Payload.size()).ToLocalChecked();
+    }
+    else if (Message->get_opcode() == websocketpp::frame::opcode::BINARY)
+    {
+#if !defined(HAS_ARRAYBUFFER_NEW_WITHOUT_STL) && !defined(USING_IN_UNREAL_ENGINE)
+        // 零拷贝：ArrayBuffer直接引用消息的payload，由BackingStore持有消息的引用计数
+        auto Backing = v8::ArrayBuffer::NewBackingStore(const_cast<char*>(Payload.data()), Payload.size(),
+            OnMessageBackingStoreFree, new wspp_message_ptr(Message));
+        return v8::ArrayBuffer::New(Isolate, std::move(Backing));
+#else
+        // 消息在派发后即释放，无法零拷贝，需要复制一份
+        auto Ab = v8::ArrayBuffer::New(Isolate, Payload.size());
+        if (Payload.size() > 0)
+        {
+            ::memcpy(DataTransfer::GetArrayBufferData(Ab), Payload.data(), Payload.size());
+        }
+        return Ab;
+#endif
+    }
+    return v8::Undefined(Isolate);
+}
+
 #if defined(WITH_WEBSOCKET_SSL)
 websocketpp::lib::shared_ptr<puerts_asio::ssl::context> on_tls_init(websocketpp::connection_hdl)
 {
@@ -208,6 +286,22 @@ void V8WebSocketClientImpl::Connect(const v8::FunctionCallbackInfo<v8::Value>& I
     // exchanged until the event loop starts running in the next line.
     Client.connect(con);
     Connenting = true;
+
+    UseIOThread = Info.Length() > 1 && Info[1]->BooleanValue(Isolate);
+    if (UseIOThread)
+    {
+        IOThread = std::thread(
+            [this]()
+            {
+                try
+                {
+                    Client.run();
+                }
+                catch (const wspp_exception&)
+                {
+                }
+            });
+    }
 }
 
 void V8WebSocketClientImpl::Send(const v8::FunctionCallbackInfo<v8::Value>& Info)
@@ -321,88 +415,115 @@ void V8WebSocketClientImpl::Close(websocketpp::close::status::value const code,
 
 void V8WebSocketClientImpl::PollOne()
 {
-    if (Connenting || !Handle.expired())
+    if (UseIOThread)
+    {
+        // 一次poll把后台线程积累的事件全部派发，共用一个HandleScope
+        if (!Isolate)
+        {
+            return;
+        }
+        v8::Isolate::Scope IsolateScope(Isolate);
+        v8::HandleScope HandleScope(Isolate);
+        FWebSocketEvent Event;
+        while (Isolate && EventQueue.Pop(Event))
+        {
+            DispatchEvent(Event);
+        }
+    }
+    else if (Connenting || !Handle.expired())
     {
         Client.poll_one();
     }
 }
 
-void V8WebSocketClientImpl::OnOpen(wspp_connection_hdl InHandle)
+void V8WebSocketClientImpl::PushEvent(FWebSocketEvent&& Event)
 {
-    Handle = InHandle;
-    Connenting = false;
-
-    v8::Isolate::Scope IsolateScope(Isolate);
-    v8::HandleScope HandleScope(Isolate);
-    if (!Handles[ON_OPEN].IsEmpty())
+    if (UseIOThread)
     {
-        v8::Local<v8::Value> args[1];
-        // must not raise exception in js, recommend just push a pending msg and process later.
-        Handles[ON_OPEN].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 0, args);
+        EventQueue.Push(std::move(Event));
+    }
+    else
+    {
+        v8::Isolate::Scope IsolateScope(Isolate);
+        v8::HandleScope HandleScope(Isolate);
+        DispatchEvent(Event);
     }
 }
 
-void V8WebSocketClientImpl::OnMessage(wspp_connection_hdl InHandle, wspp_message_ptr InMessage)
+void V8WebSocketClientImpl::DispatchEvent(FWebSocketEvent& Event)
 {
-    v8::Isolate::Scope IsolateScope(Isolate);
-    v8::HandleScope HandleScope(Isolate);
-
-    if (!Handles[ON_MESSAGE].IsEmpty())
+    // must not raise exception in js, recommend just push a pending msg and process later.
+    switch (Event.Type)
     {
-        v8::Local<v8::Value> args[1];
-        if (InMessage->get_opcode() == websocketpp::frame::opcode::TEXT)
+        case ON_OPEN:
         {
-            args[0] = v8::String::NewFromUtf8(
-                Isolate, InMessage->get_payload().c_str(), v8::NewStringType::kNormal, InMessage->get_payload().size())
-                          .ToLocalChecked();
+            Handle = Event.Handle;
+            Connenting = false;
+            if (!Handles[ON_OPEN].IsEmpty())
+            {
+                v8::Local<v8::Value> args[1];
+                Handles[ON_OPEN].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 0, args);
+            }
+            break;
+        }
+        case ON_MESSAGE:
+        {
+            if (!Handles[ON_MESSAGE].IsEmpty())
+            {
+                v8::Local<v8::Value> args[1] = {MessageToValue(Event.Message)};
+                Handles[ON_MESSAGE].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 1, args);
+            }
+            break;
         }
-        else if (InMessage->get_opcode() == websocketpp::frame::opcode::BINARY)
+        case ON_CLOSE:
         {
-            args[0] = DataTransfer::NewArrayBuffer(
-                GContext.Get(Isolate), (void*) InMessage->get_payload().c_str(), InMessage->get_payload().size());
+            if (!Handles[ON_CLOSE].IsEmpty())
+            {
+                v8::Local<v8::Value> args[2] = {v8::Integer::New(Isolate, Event.CloseCode),
+                    v8::String::NewFromUtf8(Isolate, Event.Reason.c_str(), v8::NewStringType::kNormal, Event.Reason.size())
+                        .ToLocalChecked()};
+                Handles[ON_CLOSE].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 2, args);
+            }
+            Cleanup();
+            break;
         }
-        else
+        case ON_FAIL:
         {
-            args[0] = v8::Undefined(Isolate);
+            if (!Handles[ON_FAIL].IsEmpty())
+            {
+                v8::Local<v8::Value> args[1] = {
+                    v8::String::NewFromUtf8(Isolate, Event.Reason.c_str(), v8::NewStringType::kNormal, Event.Reason.size())
+                        .ToLocalChecked()};
+                Handles[ON_FAIL].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 1, args);
+            }
+            Close(websocketpp::close::status::abnormal_close, "");
+            break;
         }
-        // must not raise exception in js, recommend just push a pending msg and process later.
-        Handles[ON_MESSAGE].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 1, args);
+        default:
+            break;
     }
 }
 
-void V8WebSocketClientImpl::OnClose(wspp_connection_hdl InHandle)
+void V8WebSocketClientImpl::OnOpen(wspp_connection_hdl InHandle)
 {
-    v8::Isolate::Scope IsolateScope(Isolate);
-    v8::HandleScope HandleScope(Isolate);
+    PushEvent(FWebSocketEvent{ON_OPEN, InHandle, nullptr, 0, std::string()});
+}
 
-    if (!Handles[ON_CLOSE].IsEmpty())
-    {
-        wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle);
-        v8::Local<v8::Value> args[2] = {v8::Integer::New(Isolate, con->get_remote_close_code()),
-            v8::String::NewFromUtf8(
-                Isolate, con->get_remote_close_reason().c_str(), v8::NewStringType::kNormal, con->get_remote_close_reason().size())
-                .ToLocalChecked()};
-        // must not raise exception in js, recommend just push a pending msg and process later.
-        Handles[ON_CLOSE].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 2, args);
-    }
-    Cleanup();
+void V8WebSocketClientImpl::OnMessage(wspp_connection_hdl InHandle, wspp_message_ptr InMessage)
+{
+    PushEvent(FWebSocketEvent{ON_MESSAGE, InHandle, InMessage, 0, std::string()});
 }
 
-void V8WebSocketClientImpl::OnFail(wspp_connection_hdl InHandle)
+void V8WebSocketClientImpl::OnClose(wspp_connection_hdl InHandle)
 {
-    v8::Isolate::Scope IsolateScope(Isolate);
-    v8::HandleScope HandleScope(Isolate);
+    wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle);
+    PushEvent(FWebSocketEvent{ON_CLOSE, InHandle, nullptr, con->get_remote_close_code(), con->get_remote_close_reason()});
+}
 
-    if (!Handles[ON_FAIL].IsEmpty())
-    {
-        wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle);
-        v8::Local<v8::Value> args[1] = {v8::String::NewFromUtf8(
-            Isolate, con->get_ec().message().c_str(), v8::NewStringType::kNormal, con->get_ec().message().size())
-                                            .ToLocalChecked()};
-        // must not raise exception in js, recommend just push a pending msg and process later.
-        Handles[ON_FAIL].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 1, args);
-    }
-    Close(websocketpp::close::status::abnormal_close, "");
+void V8WebSocketClientImpl::OnFail(wspp_connection_hdl InHandle)
+{
+    wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle);
+    PushEvent(FWebSocketEvent{ON_FAIL, InHandle, nullptr, 0, con->get_ec().message()});
 }
 
 }    // namespace PUERTS_NAMESPACE
@@ -12,6 +12,8 @@
 
 #include "CoreMinimal.h"
 
+class IMappedFileHandle;
+
 namespace PUERTS_NAMESPACE
 {
 class IJSModuleLoader
@@ -21,6 +23,13 @@ public:
 
     virtual bool Load(const FString& Path, TArray<uint8>& Content) = 0;
 
+    // 以内存映射方式打开模块文件，调用方负责释放，返回nullptr时回退到Load
+    // 映射读到的是文件原始内容，Load做了解密等处理的loader不要实现它
+    virtual IMappedFileHandle* OpenMapped(const FString& Path)
+    {
+        return nullptr;
+    }
+
     virtual FString& GetScriptRoot() = 0;
 
     virtual ~IJSModuleLoader()
@@ -31,7 +40,9 @@ public:
 class JSENV_API DefaultJSModuleLoader : public IJSModuleLoader
 {
 public:
-    explicit DefaultJSModuleLoader(const FString& InScriptRoot) : ScriptRoot(InScriptRoot)
+    // InMapFiles为true时非编辑器下大文件以内存映射方式加载，会绕过Load，子类重写了Load时不要开启
+    explicit DefaultJSModuleLoader(const FString& InScriptRoot, bool InMapFiles = false)
+        : ScriptRoot(InScriptRoot), MapFiles(InMapFiles)
     {
     }
 
@@ -39,6 +50,8 @@ public:
 
     virtual bool Load(const FString& Path, TArray<uint8>& Content) override;
 
+    virtual IMappedFileHandle* OpenMapped(const FString& Path) override;
+
     virtual FString& GetScriptRoot() override;
 
     virtual bool CheckExists(const FString& PathIn, FString& Path, FString& AbsolutePath);
@@ -48,6 +61,8 @@ public:
     virtual bool SearchModuleWithExtInDir(const FString& Dir, const FString& RequiredModule, FString& Path, FString& AbsolutePath);
 
     FString ScriptRoot;
+
+    bool MapFiles;
 };
 
 }    // namespace PUERTS_NAMESPACE
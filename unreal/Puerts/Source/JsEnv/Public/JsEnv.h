@@ -30,12 +30,20 @@ public:
 
     virtual void LowMemoryNotification() = 0;
 
+    virtual bool OnFrameIdle(double IdleBudgetInSeconds) = 0;
+
+    virtual FString GetGCPauseReport() = 0;
+
     virtual void RequestMinorGarbageCollectionForTesting() = 0;
 
     virtual void RequestFullGarbageCollectionForTesting() = 0;
 
     virtual void WaitDebugger(double Timeout) = 0;
 
+    virtual bool StartCpuProfiling(const FString& Title, int32 SamplingIntervalUs) = 0;
+
+    virtual bool StopCpuProfiling(const FString& Title, const FString& OutputPath) = 0;
+
 #if !defined(ENGINE_INDEPENDENT_JSENV)
     virtual void TryBindJs(const class UObjectBase* InObject) = 0;
 
@@ -72,6 +80,12 @@ public:
 
     void LowMemoryNotification();
 
+    // 每帧末尾传入本帧剩余时间，在这段空闲时间内推进GC及整理对象映射表
+    bool OnFrameIdle(double IdleBudgetInSeconds);
+
+    // 返回JSON，分别统计帧内和空闲时间内的GC停顿分布
+    FString GetGCPauseReport();
+
     // equivalent to Isolate->RequestGarbageCollectionForTesting(v8::Isolate::kMinorGarbageCollection)
     // It is only valid to call this function if --expose_gc was specified
     void RequestMinorGarbageCollectionForTesting();
@@ -81,6 +95,19 @@ public:
 
     void WaitDebugger(double Timeout = 0);
 
+    // 采样结果写为.cpuprofile，可直接拖入Chrome DevTools的Performance面板查看
+    bool StartCpuProfiling(const FString& Title, int32 SamplingIntervalUs = 0);
+
+    bool StopCpuProfiling(const FString& Title, const FString& OutputPath);
+
+    // 按绑定统计调用次数、总耗时及参数转换耗时，对进程内所有虚拟机生效
+    static void SetBindingProfilerEnabled(bool Enabled);
+
+    // 返回JSON数组，按总耗时降序，MaxEntries为0时返回全部
+    static FString GetBindingProfileReport(int32 MaxEntries = 0);
+
+    static void ResetBindingProfiler();
+
     void TryBindJs(const class UObjectBase* InObject);
 
     void ReloadModule(FName ModuleName, const FString& JsSource);
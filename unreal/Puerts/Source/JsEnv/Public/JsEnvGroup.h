@@ -9,8 +9,11 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <atomic>
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
 #include "JsEnv.h"
 
 namespace PUERTS_NAMESPACE
@@ -38,9 +41,26 @@ public:
 
     void SetJsEnvSelector(std::function<int(UObject*, int)> InSelector);
 
+    // 每个虚拟机绑定到各自的工作线程，组内消息（puerts.postMessage）在该线程处理，多个虚拟机可以并行执行
+    // 需要THREAD_SAFE，UFunction调用、delegate回调等仍在调用方线程同步执行；工作线程上的脚本访问UObject、UFunction、容器和delegate时会抛js异常
+    bool StartWorkerThreads();
+
+    // 以字符串形式发给第Index个虚拟机的消息处理函数，sender为-1，可在任意线程调用
+    bool PostGroupMessage(int Index, const FString& Message);
+
 private:
     std::vector<std::shared_ptr<IJsEnv>> JsEnvList;
 
+    // 大小在Init时固定，WorkersStarted之后只读，可供各线程投递消息时访问
+    std::vector<std::unique_ptr<class FJsEnvWorker>> Workers;
+
+    std::atomic<bool> WorkersStarted{false};
+
+    // 投递消息时持读锁，析构时持写锁关闭路由，之后不会再有线程访问Workers
+    FRWLock RouteLock;
+
+    bool RouteClosed = false;
+
     void Init();
 };
 
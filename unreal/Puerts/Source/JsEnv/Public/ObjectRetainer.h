@@ -10,6 +10,9 @@
 
 #include "CoreMinimal.h"
 #include "UObject/GCObject.h"
+#ifdef THREAD_SAFE
+#include "Containers/Queue.h"
+#endif
 #include "PuertsNamespaceDef.h"
 
 #ifdef THREAD_SAFE
@@ -25,6 +28,8 @@ class Isolate;
 
 namespace PUERTS_NAMESPACE
 {
+// Retained objects are kept in a dense array so the GC can walk them contiguously. The slot of an object is found
+// through its GUObjectArray index instead of hashing, so Retain/Release are O(1) (swap-remove on release).
 class JSENV_API FObjectRetainer : public FGCObject
 {
 public:
@@ -45,12 +50,38 @@ public:
 
     virtual FString GetReferencerName() const override;
 
+    FORCEINLINE int32 Num() const
+    {
+        return RetainedObjects.Num();
+    }
+
+private:
+    void RetainInternal(UObject* Object);
+
+    void ReleaseInternal(UObject* Object);
+
 #ifdef THREAD_SAFE
-    FCriticalSection RetainedObjectsCritical;
+    // Retain/Release from threads other than the game thread are queued without locking and applied on the game
+    // thread, always before the GC gathers references, so a retained object can not be missed.
+    void FlushPendingOperations();
+
+    struct FPendingOperation
+    {
+        UObject* Object;
+        bool IsRetain;
+    };
+
+    TQueue<FPendingOperation, EQueueMode::Mpsc> PendingOperations;
 #endif
 
-private:
-    TSet<UObject*> RetainedObjects;
+    // Passed to the GC as is; entries of objects marked as garbage may be nulled by the GC.
+    TArray<UObject*> RetainedObjects;
+
+    // GUObjectArray index of the object in the same slot, kept apart since the GC may clear RetainedObjects entries.
+    TArray<int32> RetainedObjectIndices;
+
+    // GUObjectArray index -> slot + 1, 0 if not retained.
+    TArray<int32> SlotByObjectIndex;
 
     FString Name = TEXT("FObjectRetainer");
 };
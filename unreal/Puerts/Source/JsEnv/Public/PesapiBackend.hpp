@@ -102,6 +102,23 @@ struct API
     {
         return pesapi_get_env(info);
     }
+
+    inline static unsigned int GetValueKind(pesapi_env env, pesapi_value value)
+    {
+        if (pesapi_is_double(env, value) || pesapi_is_int32(env, value) || pesapi_is_uint32(env, value))
+            return ValueKind::Number;
+        if (pesapi_is_object(env, value))
+            return ValueKind::Object;
+        if (pesapi_is_string(env, value))
+            return ValueKind::String;
+        if (pesapi_is_boolean(env, value))
+            return ValueKind::Boolean;
+        if (pesapi_is_undefined(env, value))
+            return ValueKind::Undefined;
+        if (pesapi_is_null(env, value))
+            return ValueKind::Null;
+        return ValueKind::Other;
+    }
     inline static pesapi_value GetThis(pesapi_callback_info info)
     {
         return pesapi_get_this(info);
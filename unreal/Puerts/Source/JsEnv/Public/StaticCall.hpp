@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -169,6 +170,91 @@ struct ArgumentChecker<API, Pos, StopPos, ArgType, Rest...>
     }
 };
 
+// The ValueKind set an argument's converter can possibly accept. It may be wider than what accept() really takes
+// (it only filters candidates), but never narrower. Types not listed here accept any kind.
+template <typename T, typename Enable = void>
+struct ArgumentKindMaskImpl
+{
+    static constexpr unsigned int value = ValueKind::All;
+};
+
+template <>
+struct ArgumentKindMaskImpl<bool>
+{
+    static constexpr unsigned int value = ValueKind::Boolean;
+};
+
+template <typename T>
+struct ArgumentKindMaskImpl<T, typename std::enable_if<(std::is_integral<T>::value && sizeof(T) < 8) || std::is_enum<T>::value ||
+                                                       std::is_floating_point<T>::value>::type>
+{
+    static constexpr unsigned int value = ValueKind::Number;
+};
+
+// 64-bit integers are passed as bigint
+template <typename T>
+struct ArgumentKindMaskImpl<T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 8>::type>
+{
+    static constexpr unsigned int value = ValueKind::Number | ValueKind::Other;
+};
+
+template <>
+struct ArgumentKindMaskImpl<std::string>
+{
+    static constexpr unsigned int value = ValueKind::String;
+};
+
+template <>
+struct ArgumentKindMaskImpl<const char*>
+{
+    static constexpr unsigned int value = ValueKind::String;
+};
+
+// non-const lvalue references are boxed in an object
+template <typename T>
+struct ArgumentKindMaskImpl<std::reference_wrapper<T>>
+{
+    static constexpr unsigned int value = ValueKind::Object;
+};
+
+template <typename T>
+struct ArgumentKindMaskImpl<T,
+    typename std::enable_if<std::is_class<T>::value && (is_objecttype<T>::value || is_uetype<T>::value)>::type>
+{
+    static constexpr unsigned int value = ValueKind::Object;
+};
+
+template <typename T>
+using ArgumentKindMask = ArgumentKindMaskImpl<typename ConverterDecay<T>::type>;
+
+// Kind masks of the leading arguments packed one byte per argument, arguments past KindSignatureArgs are not filtered
+static constexpr int KindSignatureArgs = 8;
+
+template <std::size_t Pos, typename... Args>
+struct ArgumentsKindSignature
+{
+    static constexpr uint64_t value = 0;
+};
+
+template <std::size_t Pos, typename T, typename... Rest>
+struct ArgumentsKindSignature<Pos, T, Rest...>
+{
+    static constexpr uint64_t value = (Pos < KindSignatureArgs ? static_cast<uint64_t>(ArgumentKindMask<T>::value)
+                                                                     << (Pos < KindSignatureArgs ? Pos * 8 : 0)
+                                                               : 0) |
+                                      ArgumentsKindSignature<Pos + 1, Rest...>::value;
+};
+
+template <typename Tuple>
+struct TupleKindSignature;
+
+template <typename... Args>
+struct TupleKindSignature<std::tuple<Args...>>
+{
+    static constexpr int length = sizeof...(Args);
+    static constexpr uint64_t value = ArgumentsKindSignature<0, Args...>::value;
+};
+
 template <typename API, typename Enable = void>
 struct ExceptionHandle;
 
@@ -1242,49 +1328,115 @@ struct ConstructorsCombiner
     }
 };
 
+// argument count and kind signature of an overload, length -1 means unknown (matches any call)
+template <typename OverloadWrap>
+struct OverloadSignature
+{
+    static constexpr int length = -1;
+    static constexpr uint64_t kinds = ~static_cast<uint64_t>(0);
+};
+
+template <typename API, typename T, T func, bool ReturnByPointer, bool ScriptTypePtrAsRef, bool GetSelfFromData>
+struct OverloadSignature<FuncCallWrapper<API, T, func, ReturnByPointer, ScriptTypePtrAsRef, GetSelfFromData>>
+{
+    using KindSignature = internal::TupleKindSignature<typename internal::traits::FunctionTrait<T>::Arguments>;
+    static constexpr int length = KindSignature::length;
+    static constexpr uint64_t kinds = KindSignature::value;
+};
+
+// Overloads are grouped by argument count once, when registered. A call classifies its arguments in one pass and only
+// runs the full argument checks of the overloads whose kind signature matches, in declaration order.
 template <typename API, typename... OverloadWraps>
 struct OverloadsCombiner
 {
     typedef bool (*V8FunctionCallbackWithBoolRet)(typename API::CallbackInfoType info);
 
-    template <V8FunctionCallbackWithBoolRet Func, V8FunctionCallbackWithBoolRet... Rest>
-    struct OverloadsRecursion
+    struct OverloadEntry
     {
-        static bool _call(typename API::CallbackInfoType info)
-        {
-            if (Func(info))
-                return true;
-            else
-                return OverloadsRecursion<Rest...>::_call(info);
-        }
+        uint64_t Kinds;
+        V8FunctionCallbackWithBoolRet Call;
+    };
+
+    struct DispatchTable
+    {
+        // index by argument count, the last one is for counts no overload declares
+        std::vector<std::vector<OverloadEntry>> Buckets;
 
-        static void call(typename API::CallbackInfoType info)
+        DispatchTable()
         {
-            if (!_call(info))
+            const int Lengths[] = {OverloadSignature<OverloadWraps>::length...};
+            const OverloadEntry Entries[] = {{OverloadSignature<OverloadWraps>::kinds, &OverloadWraps::overloadCall}...};
+            int MaxLength = 0;
+            for (int Length : Lengths)
+            {
+                MaxLength = Length > MaxLength ? Length : MaxLength;
+            }
+            Buckets.resize(MaxLength + 2);
+            for (size_t i = 0; i < sizeof...(OverloadWraps); ++i)
             {
-                API::ThrowException(info, "invalid parameter!");
+                for (int Length = 0; Length < static_cast<int>(Buckets.size()); ++Length)
+                {
+                    if (Lengths[i] == Length || (Lengths[i] < 0))
+                    {
+                        Buckets[Length].push_back(Entries[i]);
+                    }
+                }
             }
         }
-    };
 
-    template <V8FunctionCallbackWithBoolRet Func>
-    struct OverloadsRecursion<Func>
-    {
-        static bool _call(typename API::CallbackInfoType info)
+        const std::vector<OverloadEntry>& Find(int ArgsLength) const
         {
-            return Func(info);
+            return ArgsLength < static_cast<int>(Buckets.size()) - 1 ? Buckets[ArgsLength] : Buckets.back();
         }
     };
 
+    // true if every one of the first Count bytes of Kinds has a bit set (kinds use the low 7 bits of each byte)
+    static bool KindsMatch(uint64_t Kinds, int Count)
+    {
+        const uint64_t HighBits = 0x8080808080808080ull;
+        const uint64_t Required = Count >= internal::KindSignatureArgs ? HighBits : HighBits & ((1ull << (Count * 8)) - 1);
+        return (((Kinds + 0x7F7F7F7F7F7F7F7Full) | Kinds) & Required) == Required;
+    }
+
+    static const DispatchTable& GetTable()
+    {
+        static const DispatchTable Table;
+        return Table;
+    }
+
     static void call(typename API::CallbackInfoType info)
     {
-        OverloadsRecursion<(&OverloadWraps::overloadCall)...>::call(info);
+        const int ArgsLength = API::GetArgsLen(info);
+        const std::vector<OverloadEntry>& Candidates = GetTable().Find(ArgsLength);
+
+        if (Candidates.size() == 1)
+        {
+            if (Candidates[0].Call(info))
+                return;
+        }
+        else if (!Candidates.empty())
+        {
+            auto context = API::GetContext(info);
+            const int Count = ArgsLength < internal::KindSignatureArgs ? ArgsLength : internal::KindSignatureArgs;
+            uint64_t ValueKinds = 0;
+            for (int i = 0; i < Count; ++i)
+            {
+                ValueKinds |= static_cast<uint64_t>(API::GetValueKind(context, API::GetArg(info, i))) << (i * 8);
+            }
+            for (const OverloadEntry& Entry : Candidates)
+            {
+                if (KindsMatch(ValueKinds & Entry.Kinds, Count) && Entry.Call(info))
+                    return;
+            }
+        }
+        API::ThrowException(info, "invalid parameter!");
     }
 
     static constexpr int length = sizeof...(OverloadWraps);
 
     static const CFunctionInfo** infos()
     {
+        GetTable();    // build the dispatch table at registration
         static const CFunctionInfo* _infos[sizeof...(OverloadWraps)] = {OverloadWraps::info()...};
         return _infos;
     }
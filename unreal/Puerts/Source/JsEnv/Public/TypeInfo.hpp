@@ -251,6 +251,23 @@ struct is_script_type : std::false_type
 {
 };
 
+// Coarse kind of a script value, one bit per kind so that an argument can accept a set of kinds.
+// Used to filter overload candidates before running their exact argument checks.
+struct ValueKind
+{
+    enum : unsigned int
+    {
+        Undefined = 1 << 0,
+        Null = 1 << 1,
+        Boolean = 1 << 2,
+        Number = 1 << 3,
+        String = 1 << 4,
+        Object = 1 << 5,
+        Other = 1 << 6,    // bigint, symbol, external...
+        All = (1 << 7) - 1
+    };
+};
+
 template <typename T>
 struct is_script_type<T, typename std::enable_if<std::is_fundamental<T>::value && !std::is_same<T, void>::value>::type>
     : std::true_type
@@ -88,6 +88,23 @@ struct API
     {
         return info.GetIsolate()->GetCurrentContext();
     }
+
+    V8_INLINE static unsigned int GetValueKind(v8::Local<v8::Context> context, const v8::Local<v8::Value>& value)
+    {
+        if (value->IsNumber())
+            return ValueKind::Number;
+        if (value->IsObject())
+            return ValueKind::Object;
+        if (value->IsString())
+            return ValueKind::String;
+        if (value->IsBoolean())
+            return ValueKind::Boolean;
+        if (value->IsUndefined())
+            return ValueKind::Undefined;
+        if (value->IsNull())
+            return ValueKind::Null;
+        return ValueKind::Other;
+    }
     V8_INLINE static v8::Local<v8::Object> GetThis(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
         return info.This();
@@ -10,11 +10,44 @@
 
 #pragma warning(push, 0)
 #include <v8-fast-api-calls.h>
+#include <v8-version.h>
 #pragma warning(pop)
+#include <string>
+#include <cstring>
 #include "DataTransfer.h"
 
+#if V8_MAJOR_VERSION >= 10
+#define PUERTS_FAST_CALL_ONE_BYTE_STRING 1
+#else
+#define PUERTS_FAST_CALL_ONE_BYTE_STRING 0
+#endif
+
+// FastApiCallbackOptions::fallback lets a fast call hand over to the slow callback, later V8 versions removed it
+#if V8_MAJOR_VERSION >= 9 && V8_MAJOR_VERSION < 12
+#define PUERTS_FAST_CALL_FALLBACK 1
+#else
+#define PUERTS_FAST_CALL_FALLBACK 0
+#endif
+
+#if V8_MAJOR_VERSION >= 11 && PUERTS_FAST_CALL_FALLBACK
+#define PUERTS_FAST_CALL_TYPED_ARRAY 1
+#else
+#define PUERTS_FAST_CALL_TYPED_ARRAY 0
+#endif
+
+#if PUERTS_FAST_CALL_TYPED_ARRAY
+#include "ArrayBuffer.h"
+#endif
+
 namespace PUERTS_NAMESPACE
 {
+// defined in TypeInfo.hpp, which includes this file first
+template <typename T>
+struct is_uetype;
+
+template <typename T>
+struct is_objecttype;
+
 template <typename T, typename Enable = void>
 struct FastCallArgument
 {
@@ -77,6 +110,174 @@ struct FastCallArgument<bool>
     }
 };
 
+#if PUERTS_FAST_CALL_FALLBACK
+// const reference to a bound struct/class: read the pointer from the internal fields like the pointer case above,
+// anything that is not a wrapped object falls back to the slow path through Check.
+// non-const references are passed as $ref wrappers and still take the slow path
+template <typename T>
+struct FastCallArgument<T,
+    typename std::enable_if<std::is_lvalue_reference<T>::value && std::is_const<typename std::remove_reference<T>::type>::value &&
+                            (is_objecttype<typename std::decay<T>::type>::value ||
+                                is_uetype<typename std::decay<T>::type>::value) &&
+                            std::is_default_constructible<typename std::decay<T>::type>::value>::type>
+{
+    using DeclType = v8::Local<v8::Value>;
+
+    using DecayType = typename std::decay<T>::type;
+
+    static bool Check(v8::Local<v8::Value> v)
+    {
+        return v->IsObject() && DataTransfer::GetPointerFast<DecayType>(v.As<v8::Object>()) != nullptr;
+    }
+
+    static T Get(v8::Local<v8::Value> v)
+    {
+        return *DataTransfer::GetPointerFast<DecayType>(v.As<v8::Object>());
+    }
+};
+#endif
+
+#if PUERTS_FAST_CALL_ONE_BYTE_STRING
+namespace internal
+{
+namespace fastcallutil
+{
+// one-byte strings are latin1, the slow path hands utf8 to c++
+FORCEINLINE void Latin1ToUtf8(const char* Data, uint32_t Length, std::string& Out)
+{
+    Out.clear();
+    Out.reserve(Length);
+    for (uint32_t i = 0; i < Length; ++i)
+    {
+        const unsigned char C = static_cast<unsigned char>(Data[i]);
+        if (C < 0x80)
+        {
+            Out.push_back(static_cast<char>(C));
+        }
+        else
+        {
+            Out.push_back(static_cast<char>(0xC0 | (C >> 6)));
+            Out.push_back(static_cast<char>(0x80 | (C & 0x3F)));
+        }
+    }
+}
+
+FORCEINLINE bool IsAscii(const char* Data, uint32_t Length)
+{
+    for (uint32_t i = 0; i < Length; ++i)
+    {
+        if (static_cast<unsigned char>(Data[i]) >= 0x80)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// FastOneByteString is not null-terminated, copy it into a buffer that lives until the call returns
+class FastCallStringHolder
+{
+public:
+    explicit FastCallStringHolder(const v8::FastOneByteString& Str)
+    {
+        if (Str.length < sizeof(Inline) && IsAscii(Str.data, Str.length))
+        {
+            memcpy(Inline, Str.data, Str.length);
+            Inline[Str.length] = '\0';
+            Ptr = Inline;
+        }
+        else
+        {
+            Latin1ToUtf8(Str.data, Str.length, Heap);
+            Ptr = Heap.c_str();
+        }
+    }
+
+    FastCallStringHolder(const FastCallStringHolder& Other) : Heap(Other.Heap)
+    {
+        if (Other.Ptr == Other.Inline)
+        {
+            memcpy(Inline, Other.Inline, sizeof(Inline));
+            Ptr = Inline;
+        }
+        else
+        {
+            Ptr = Heap.c_str();
+        }
+    }
+
+    FastCallStringHolder& operator=(const FastCallStringHolder&) = delete;
+
+    operator const char*() const
+    {
+        return Ptr;
+    }
+
+private:
+    char Inline[128];
+
+    std::string Heap;
+
+    const char* Ptr;
+};
+}    // namespace fastcallutil
+}    // namespace internal
+
+template <>
+struct FastCallArgument<const char*>
+{
+    using DeclType = const v8::FastOneByteString&;
+
+    static internal::fastcallutil::FastCallStringHolder Get(const v8::FastOneByteString& s)
+    {
+        return internal::fastcallutil::FastCallStringHolder(s);
+    }
+};
+
+template <>
+struct FastCallArgument<std::string>
+{
+    using DeclType = const v8::FastOneByteString&;
+
+    static std::string Get(const v8::FastOneByteString& s)
+    {
+        std::string Ret;
+        internal::fastcallutil::Latin1ToUtf8(s.data, s.length, Ret);
+        return Ret;
+    }
+};
+
+template <>
+struct FastCallArgument<const std::string&> : FastCallArgument<std::string>
+{
+};
+#endif
+
+#if PUERTS_FAST_CALL_TYPED_ARRAY
+// only Uint8Array takes the fast path, ArrayBuffer and other views fall back to the slow path
+template <>
+struct FastCallArgument<FArrayBuffer>
+{
+    using DeclType = const v8::FastApiTypedArray<uint8_t>&;
+
+    static bool Check(const v8::FastApiTypedArray<uint8_t>& a)
+    {
+        uint8_t* Data = nullptr;
+        return a.getStorageIfAligned(&Data);
+    }
+
+    static FArrayBuffer Get(const v8::FastApiTypedArray<uint8_t>& a)
+    {
+        uint8_t* Data = nullptr;
+        a.getStorageIfAligned(&Data);
+        FArrayBuffer Ret;
+        Ret.Data = Data;
+        Ret.Length = a.length();
+        return Ret;
+    }
+};
+#endif
+
 namespace internal
 {
 namespace fastcallutil
@@ -109,6 +310,108 @@ using Void_t = void;
 }    // namespace fastcallutil
 }    // namespace internal
 
+// enums are returned like enum arguments are passed
+template <typename T, typename = void>
+struct FastCallReturn
+{
+    using DeclType = T;
+};
+
+template <typename T>
+struct FastCallReturn<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+    using DeclType = int;
+};
+
+// arguments with a Check need FastApiCallbackOptions to bail out to the slow path
+template <typename T, typename = void>
+struct HasFastCallCheck : std::false_type
+{
+};
+
+template <typename T>
+struct HasFastCallCheck<T, internal::fastcallutil::Void_t<decltype(&FastCallArgument<T>::Check)>> : std::true_type
+{
+};
+
+namespace internal
+{
+namespace fastcallutil
+{
+template <typename T>
+FORCEINLINE typename std::enable_if<HasFastCallCheck<T>::value, bool>::type CheckArgument(
+    typename FastCallArgument<T>::DeclType a)
+{
+    return FastCallArgument<T>::Check(a);
+}
+
+template <typename T>
+FORCEINLINE typename std::enable_if<!HasFastCallCheck<T>::value, bool>::type CheckArgument(
+    typename FastCallArgument<T>::DeclType)
+{
+    return true;
+}
+
+template <typename... Args>
+FORCEINLINE bool CheckArguments(typename FastCallArgument<Args>::DeclType... args)
+{
+    bool Ret = true;
+    using Expander = int[];
+    (void) Expander{0, (Ret = Ret && CheckArgument<Args>(args), 0)...};
+    return Ret;
+}
+
+template <typename... Args>
+struct AnyChecked : std::false_type
+{
+};
+
+template <typename First, typename... Rest>
+struct AnyChecked<First, Rest...>
+    : std::integral_constant<bool, HasFastCallCheck<First>::value || AnyChecked<Rest...>::value>
+{
+};
+
+// Caller::Call does the actual invocation, Wrap is what gets registered as the CFunction
+template <typename Caller, typename Ret, typename ArgsTuple, bool Checked>
+struct FastCallWrapper;
+
+template <typename Caller, typename Ret, typename... Args>
+struct FastCallWrapper<Caller, Ret, std::tuple<Args...>, false>
+{
+    using RetDeclType = typename FastCallReturn<Ret>::DeclType;
+
+    static RetDeclType Wrap(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
+    {
+        return static_cast<RetDeclType>(Caller::Call(receiver_obj, args...));
+    }
+};
+
+#if PUERTS_FAST_CALL_FALLBACK
+template <typename Caller, typename Ret, typename... Args>
+struct FastCallWrapper<Caller, Ret, std::tuple<Args...>, true>
+{
+    using RetDeclType = typename FastCallReturn<Ret>::DeclType;
+
+    static RetDeclType Wrap(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args,
+        v8::FastApiCallbackOptions& options)
+    {
+        if (V8_UNLIKELY(!CheckArguments<Args...>(args...)))
+        {
+            // V8 ignores the return value and calls the slow callback instead
+            options.fallback = true;
+            return RetDeclType();
+        }
+        return static_cast<RetDeclType>(Caller::Call(receiver_obj, args...));
+    }
+};
+#endif
+
+template <typename Caller, typename Ret, typename... Args>
+using FastCallWrapperOf = FastCallWrapper<Caller, Ret, std::tuple<Args...>, AnyChecked<Args...>::value>;
+}    // namespace fastcallutil
+}    // namespace internal
+
 template <typename T, typename = void>
 struct IsArgSupportedHelper : std::false_type
 {
@@ -135,15 +438,18 @@ struct IsReturnSupportedHelper : std::false_type
 {
 };
 
+// only value types V8 can return directly, strings, buffers and objects go through the slow path
 template <typename T>
-struct IsReturnSupportedHelper<T,
-    typename std::enable_if<IsArgSupportedHelper<T>::value && !std::is_pointer<T>::value && !std::is_integral<T>::value>::type>
+struct IsReturnSupportedHelper<T, typename std::enable_if<std::is_floating_point<T>::value || std::is_enum<T>::value>::type>
     : std::true_type
 {
 };
 
+// V8 only accepts bool and 32 bit integers as integral returns, narrower integers go through the slow path
 template <typename T>
-struct IsReturnSupportedHelper<T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) < 8>::type> : std::true_type
+struct IsReturnSupportedHelper<T,
+    typename std::enable_if<std::is_integral<T>::value && (std::is_same<T, bool>::value || sizeof(T) == 4)>::type>
+    : std::true_type
 {
 };
 
@@ -165,15 +471,16 @@ template <typename Ret, typename... Args, Ret (*func)(Args...)>
 struct V8FastCall<Ret (*)(Args...), func,
     typename std::enable_if<IsReturnSupportedHelper<Ret>::value && IsArgsSupportedHelper<std::tuple<Args...>>::value &&
                             (sizeof...(Args) > 0)>::type>
+    : internal::fastcallutil::FastCallWrapperOf<V8FastCall<Ret (*)(Args...), func>, Ret, Args...>
 {
-    static Ret Wrap(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
+    static Ret Call(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
     {
         return func(FastCallArgument<Args>::Get(args)...);
     }
 
     static const v8::CFunction* info()
     {
-        static v8::CFunction _info = v8::CFunction::Make(Wrap);
+        static v8::CFunction _info = v8::CFunction::Make(V8FastCall::Wrap);
         return &_info;
     }
 };
@@ -181,8 +488,9 @@ struct V8FastCall<Ret (*)(Args...), func,
 template <typename Inc, typename Ret, typename... Args, Ret (Inc::*func)(Args...)>
 struct V8FastCall<Ret (Inc::*)(Args...), func,
     typename std::enable_if<IsReturnSupportedHelper<Ret>::value && IsArgsSupportedHelper<std::tuple<Args...>>::value>::type>
+    : internal::fastcallutil::FastCallWrapperOf<V8FastCall<Ret (Inc::*)(Args...), func>, Ret, Args...>
 {
-    static Ret Wrap(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
+    static Ret Call(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
     {
         auto self = FastCallArgument<Inc*>::Get(receiver_obj);
         return (self->*func)(FastCallArgument<Args>::Get(args)...);
@@ -190,7 +498,7 @@ struct V8FastCall<Ret (Inc::*)(Args...), func,
 
     static const v8::CFunction* info()
     {
-        static v8::CFunction _info = v8::CFunction::Make(Wrap);
+        static v8::CFunction _info = v8::CFunction::Make(V8FastCall::Wrap);
         return &_info;
     }
 };
@@ -198,8 +506,9 @@ struct V8FastCall<Ret (Inc::*)(Args...), func,
 template <typename Inc, typename Ret, typename... Args, Ret (Inc::*func)(Args...) const>
 struct V8FastCall<Ret (Inc::*)(Args...) const, func,
     typename std::enable_if<IsReturnSupportedHelper<Ret>::value && IsArgsSupportedHelper<std::tuple<Args...>>::value>::type>
+    : internal::fastcallutil::FastCallWrapperOf<V8FastCall<Ret (Inc::*)(Args...) const, func>, Ret, Args...>
 {
-    static Ret Wrap(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
+    static Ret Call(v8::Local<v8::Object> receiver_obj, typename FastCallArgument<Args>::DeclType... args)
     {
         auto self = FastCallArgument<Inc*>::Get(receiver_obj);
         return (self->*func)(FastCallArgument<Args>::Get(args)...);
@@ -207,7 +516,7 @@ struct V8FastCall<Ret (Inc::*)(Args...) const, func,
 
     static const v8::CFunction* info()
     {
-        static v8::CFunction _info = v8::CFunction::Make(Wrap);
+        static v8::CFunction _info = v8::CFunction::Make(V8FastCall::Wrap);
         return &_info;
     }
 };
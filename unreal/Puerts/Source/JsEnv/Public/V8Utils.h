@@ -31,6 +31,22 @@ enum ArgType
 class JSENV_API FV8Utils
 {
 public:
+    // JsEnvGroup的工作线程上为true，该线程上运行的脚本不能访问UObject/UFunction
+    static void SetWorkerThread(bool InIsWorkerThread);
+
+    static bool IsWorkerThread();
+
+    // 在工作线程上时抛出js异常并返回false
+    FORCEINLINE static bool CheckUEAccessThread(v8::Isolate* Isolate)
+    {
+        if (!IsWorkerThread())
+        {
+            return true;
+        }
+        ThrowException(Isolate, "can not access UE objects on a JsEnvGroup worker thread");
+        return false;
+    }
+
     FORCEINLINE static void ThrowException(v8::Isolate* Isolate, const FString& Message)
     {
         ThrowException(Isolate, TCHAR_TO_ANSI(*Message));
@@ -312,6 +328,12 @@ public:
         return;                                       \
     }
 
+#define CHECK_UE_ACCESS_THREAD(Isolate)            \
+    if (!FV8Utils::CheckUEAccessThread(Isolate))   \
+    {                                              \
+        return;                                    \
+    }
+
 #define CHECK_V8_ARGS(...)                                 \
     static std::vector<ArgType> ArgExpect = {__VA_ARGS__}; \
     if (!FV8Utils::CheckArgument(Info, ArgExpect))         \
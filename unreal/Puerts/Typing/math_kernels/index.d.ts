@@ -0,0 +1,40 @@
+declare module "math_kernels" {
+    // Vectors are passed as SoA (one array per component), quaternions as packed xyzw.
+    // All float arrays in one call must share the same type and length; output arrays may alias inputs.
+    type FloatArray = Float32Array | Float64Array;
+
+    // true when Float32Array kernels run on SSE
+    const SIMD: boolean;
+
+    function add(out: FloatArray, a: FloatArray, b: FloatArray): void;
+
+    function sub(out: FloatArray, a: FloatArray, b: FloatArray): void;
+
+    function scale(out: FloatArray, a: FloatArray, s: number): void;
+
+    // out = a + b * s
+    function scaleAdd(out: FloatArray, a: FloatArray, b: FloatArray, s: number): void;
+
+    function dot3(out: FloatArray, ax: FloatArray, ay: FloatArray, az: FloatArray, bx: FloatArray, by: FloatArray, bz: FloatArray): void;
+
+    function cross3(ox: FloatArray, oy: FloatArray, oz: FloatArray, ax: FloatArray, ay: FloatArray, az: FloatArray,
+        bx: FloatArray, by: FloatArray, bz: FloatArray): void;
+
+    function length3(out: FloatArray, x: FloatArray, y: FloatArray, z: FloatArray): void;
+
+    // zero-length vectors are normalized to zero
+    function normalize3(ox: FloatArray, oy: FloatArray, oz: FloatArray, x: FloatArray, y: FloatArray, z: FloatArray): void;
+
+    function distance3(out: FloatArray, x: FloatArray, y: FloatArray, z: FloatArray, px: number, py: number, pz: number): void;
+
+    // writes the indices within radius to outIndices and returns the total hit count, which may exceed outIndices.length
+    function queryRadius3(x: FloatArray, y: FloatArray, z: FloatArray, px: number, py: number, pz: number, radius: number,
+        outIndices: Int32Array): number;
+
+    // matrix is a row-major 4x4 with translation in the last row, same layout as FMatrix
+    function transformPosition3(ox: FloatArray, oy: FloatArray, oz: FloatArray, x: FloatArray, y: FloatArray, z: FloatArray,
+        matrix: FloatArray): void;
+
+    // out[i] = a[i] * b[i], same as FQuat multiplication
+    function quatMul(out: FloatArray, a: FloatArray, b: FloatArray): void;
+}
@@ -70,6 +70,12 @@ declare module "puerts" {
     
     function releaseManualReleaseDelegate<T extends (...args: any) => any>(func: T): void;
     
+    // Only available in a JsEnvGroup. data is structured-cloned, so UE objects can not be sent; returns false for a bad target.
+    function postMessage(target: number, data: any): boolean;
+    
+    // sender is -1 for messages posted from C++. Runs on the env's worker thread after FJsEnvGroup::StartWorkerThreads.
+    function setMessageHandler(handler: ((data: any, sender: number) => void) | undefined): void;
+    
     function toDelegate<T extends Object, K extends keyof T>(obj: T, key: T[K] extends (...args: any) => any ? K : never) : $Delegate<T[K] extends (...args: any) => any ? T[K] : never>;
     
     function toDelegate<T extends (...args: any) => any>(owner: Object, callback: T): $Delegate<T>;
@@ -44,6 +44,8 @@ declare module "ue" {
         RemoveAt(Index: number): void;
         IsValidIndex(Index: number): boolean;
         Empty(): void;
+        EnableHashIndex(): void;        // 开启后Contains/FindIndex走哈希索引，元素类型需支持哈希
+        InvalidateHashIndex(): void;    // 通过GetRef的引用或在C++侧原地修改元素后调用
         [Symbol.iterator](): IterableIterator<T>;
     }
     
@@ -137,6 +139,8 @@ declare module "ue" {
     type TSoftObjectPtr<T> = {
         Get():T;
         LoadSynchronous(): T;
+        // async loading, resolved once per frame, undefined if loading failed
+        LoadAsync(): Promise<T | undefined>;
     }
 
     type TLazyObjectPtr<T> = {
@@ -150,6 +154,7 @@ declare module "ue" {
     type TSoftClassPtr<T> = {
         Get():Class;
         LoadSynchronous(): Class;
+        LoadAsync(): Promise<Class | undefined>;
     }
 
     class UInt64Ptr { }